@@ -0,0 +1,81 @@
+/****************************************************
+ * Author: Gal Maymon
+ * Email: galmaymon@gmail.com
+ *
+ * Description:
+ * Throughput benchmark of SquareMatrixBatch, in matrices per nanosecond.
+ * For each small size it times the batched product and sum over a batch of
+ * many matrices, repeating each kernel until at least MIN_SECONDS have passed,
+ * and compares the product with one SquareMatrix multiplication per matrix.
+ *
+ * Build and run with `make bench` (optimized, without coverage or debug logging).
+ * An optional argument sets the number of matrices per batch.
+ ****************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "../Matrix/SquareMatrixBatch.hpp"
+
+using namespace SquareMatrixGM;
+
+namespace {
+    const double MIN_SECONDS = 0.2;
+
+    /**
+     * @brief Runs kernel() until MIN_SECONDS have passed; returns matrices per nanosecond.
+     */
+    template <typename Kernel>
+    double throughput(int matrices, Kernel kernel) {
+        using Clock = std::chrono::steady_clock;
+        kernel(); // warm-up: page in the operands and the result
+        long repetitions = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+        do {
+            kernel();
+            ++repetitions;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < MIN_SECONDS);
+        return static_cast<double>(matrices) * repetitions / (elapsed * 1e9);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 16384;
+    if (count < 1) {
+        std::cerr << "usage: " << argv[0] << " [matrices per batch]\n";
+        return 1;
+    }
+    const int sizes[] = {2, 3, 4, 6, 8};
+    double sink = 0.0;
+
+    std::cout << "SquareMatrixBatch throughput, " << count << " matrices per batch\n";
+    std::cout << std::setw(4) << "n" << std::setw(20) << "batch * (mat/ns)" << std::setw(20) << "batch + (mat/ns)"
+              << std::setw(24) << "SquareMatrix * (mat/ns)" << '\n';
+    for (int n : sizes) {
+        SquareMatrixBatch a(n, count), b(n, count);
+        for (int m = 0; m < count; ++m)
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j) {
+                    a.at(m, i, j) = 1.0 + (m + i * n + j) % 7;
+                    b.at(m, i, j) = 0.5 * ((m * 3 + i + j) % 5);
+                }
+        double product = throughput(count, [&] { sink += (a * b).at(0, 0, 0); });
+        double sum = throughput(count, [&] { sink += (a + b).at(0, 0, 0); });
+
+        // Baseline: one SquareMatrix product per matrix, on operands that stay in cache.
+        SquareMatrix left = a.get(0), right = b.get(0);
+        const int repeats = 256;
+        double single = throughput(repeats, [&] {
+            for (int m = 0; m < repeats; ++m)
+                sink += (left * right)[0][0];
+        });
+
+        std::cout << std::setw(4) << n << std::setprecision(4) << std::setw(20) << product
+                  << std::setw(20) << sum << std::setw(24) << single << '\n';
+    }
+    std::cout << "(checksum " << std::fixed << sink << ")\n";
+    return 0;
+}
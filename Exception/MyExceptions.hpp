@@ -12,6 +12,40 @@
  #ifndef MY_EXCEPTIONS_HPP
  #define MY_EXCEPTIONS_HPP
  
+ #include <cstdio>
+ #include <cstdlib>
+ 
+ /**
+  * @brief Error reporting that also compiles with -fno-exceptions.
+  *
+  * Library code raises errors with MATRIX_THROW and guards cleanup with MATRIX_TRY /
+  * MATRIX_CATCH_ALL / MATRIX_RETHROW. With exceptions enabled these are the plain
+  * keywords. Without them, raising an error prints its message and aborts
+  * (matrixFatalError), and the cleanup blocks compile away. Code built that way should
+  * call the non-throwing API (Status.hpp) and never reach an error.
+  */
+ #if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+ #define MATRIX_HAS_EXCEPTIONS 1
+ #define MATRIX_THROW(exception) throw exception
+ #define MATRIX_RETHROW throw
+ #define MATRIX_TRY try
+ #define MATRIX_CATCH_ALL catch (...)
+ #else
+ #define MATRIX_HAS_EXCEPTIONS 0
+ #define MATRIX_THROW(exception) matrixFatalError((exception).what())
+ #define MATRIX_RETHROW ((void)0)
+ #define MATRIX_TRY if (true)
+ #define MATRIX_CATCH_ALL else
+ #endif
+ 
+ /**
+  * @brief Reports an error that cannot be thrown (exceptions disabled) and aborts.
+  */
+ [[noreturn]] inline void matrixFatalError(const char* message) {
+     std::fprintf(stderr, "Matrix error: %s\n", message);
+     std::abort();
+ }
+ 
  /**
   * @class MyOutOfRange
   * @brief Exception for invalid access to an index in a vector.
@@ -59,5 +93,16 @@
      }
  };
  
+ /**
+  * @class MemoryBudgetExceeded
+  * @brief Exception for an allocation that would take the accounted memory past the budget.
+  */
+ class MemoryBudgetExceeded {
+ public:
+     const char* what() const {
+         return "Memory budget exceeded";
+     }
+ };
+ 
  #endif // MY_EXCEPTIONS_HPP
  
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file Status.hpp
+ * @brief Status codes and an expected-like result type for the non-throwing API.
+ *
+ * The `try...` members of Vector validate every precondition once, before their loop,
+ * and report a failure as a Status instead of throwing, so the loops themselves carry
+ * no error paths and the library can be used from code built with -fno-exceptions.
+ * The operators are thin wrappers that turn a failed Status into the usual exception.
+ *
+ * Example:
+ *     ErrorGM::Result<Vector> sum = a.tryAdd(b);
+ *     if (!sum)
+ *         return sum.status();
+ *     use(sum.value());
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#ifndef STATUS_HPP
+#define STATUS_HPP
+
+#include <utility>
+#include "MyExceptions.hpp"
+
+namespace ErrorGM {
+
+    /**
+     * @brief Outcome of a non-throwing operation.
+     */
+    enum class Status {
+        Ok,
+        SizeMismatch,    ///< Operands of different sizes
+        Uninitialized,   ///< An operand has an uninitialized cell
+        OutOfRange,      ///< Index outside the vector
+        DivisionByZero,  ///< Division or modulo by zero
+        Unsupported      ///< Not defined for the element type (modulo of complex values)
+    };
+
+    /**
+     * @brief Short description of a status, such as "Vector sizes must match".
+     */
+    inline const char* statusMessage(Status status) {
+        switch (status) {
+            case Status::Ok: return "Ok";
+            case Status::SizeMismatch: return "Vector sizes must match";
+            case Status::Uninitialized: return "Uninitialized cell in vector";
+            case Status::OutOfRange: return "Index out of range";
+            case Status::DivisionByZero: return "Division by zero";
+            case Status::Unsupported: return "Operation not defined for the element type";
+        }
+        return "Unknown status";
+    }
+
+    /**
+     * @class Result
+     * @brief A value, or the Status explaining why there is none.
+     */
+    template <typename T>
+    class Result {
+    private:
+        Status code;
+        T stored; ///< Default-constructed when code is not Ok
+
+    public:
+        Result(T value) : code(Status::Ok), stored(std::move(value)) {}
+        Result(Status status) : code(status), stored() {}
+
+        bool ok() const { return code == Status::Ok; }
+        explicit operator bool() const { return ok(); }
+        Status status() const { return code; }
+
+        /**
+         * @brief The value.
+         * @throws MyLogicError if there is none (aborts without exceptions).
+         */
+        T& value() {
+            if (code != Status::Ok)
+                MATRIX_THROW(MyLogicError(statusMessage(code)));
+            return stored;
+        }
+
+        const T& value() const {
+            if (code != Status::Ok)
+                MATRIX_THROW(MyLogicError(statusMessage(code)));
+            return stored;
+        }
+    };
+
+} // namespace ErrorGM
+
+#endif
@@ -0,0 +1,357 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Definition of the FixedSquareMatrix class template, an N x N matrix usable in constant expressions.
+ *
+ * SquareMatrix is sized at run time and keeps its rows on the heap, so a table such as
+ * a rotation matrix or a small power of a transform is rebuilt at every start through
+ * identity() and operator^. FixedSquareMatrix<T, N> stores its N * N elements inline
+ * and its construction, identity(), `*`, `^`, `~` and `!` are constexpr, so
+ *
+ *     constexpr FixedSquareMatrix<int64_t, 2> fib{{1, 1}, {1, 0}};
+ *     constexpr auto fib40 = fib ^ 40;
+ *
+ * is evaluated by the compiler and stored in the binary's read-only data. The same
+ * members also work at run time, where they allocate nothing; toSquareMatrix() hands
+ * the result to code that expects a SquareMatrix.
+ *
+ * The operators follow SquareMatrix: `!` uses the same cofactor / partial-pivoting /
+ * Bareiss determinant, and negative powers invert first (in double precision). For
+ * integer elements the inverse would be truncated, so negative powers throw, as for
+ * BasicSquareMatrix<int64_t> (inverse() itself still returns truncated entries).
+ * Unlike SquareMatrix, `~` returns the transpose instead of transposing in place, so
+ * it can be applied to constants. Errors (an index out of range, a singular inverse,
+ * a negative power of an integer matrix) throw as usual at run time and are compile
+ * errors in a constant expression. Elements must be arithmetic types,
+ * because std::complex is not constexpr-capable in C++17.
+ */
+
+#ifndef FIXED_SQUARE_MATRIX_HPP
+#define FIXED_SQUARE_MATRIX_HPP
+
+#include <initializer_list>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include "SquareMatrix.hpp"
+#include "../Exception/MyExceptions.hpp"
+
+namespace SquareMatrixGM {
+
+	/**
+	 * @class FixedSquareMatrix
+	 * @brief An N x N matrix with inline storage whose core operators are constexpr.
+	 * @tparam T Arithmetic element type.
+	 * @tparam N The size, at least 1.
+	 */
+	template <typename T, int N>
+	class FixedSquareMatrix {
+		static_assert(std::is_arithmetic<T>::value, "FixedSquareMatrix elements must be arithmetic");
+		static_assert(N > 0, "FixedSquareMatrix size must be positive");
+
+	private:
+		T data[N * N]; ///< Elements, row-major
+
+		template <typename U>
+		static constexpr U absolute(U value) { return value < U() ? -value : value; } ///< std::abs is not constexpr
+
+		static constexpr void checkIndex(int row, int col) {
+			if (row < 0 || row >= N || col < 0 || col >= N)
+				MATRIX_THROW(MyOutOfRange());
+		}
+
+		/**
+		 * @brief Inverse by Gauss-Jordan elimination with partial pivoting, in double precision.
+		 * A pivot below N * eps * ||A||_inf counts as zero, as in SquareMatrix::inverse().
+		 * @throws MyLogicError if the matrix is singular.
+		 */
+		constexpr FixedSquareMatrix inverse() const {
+			double a[N * N] = {};
+			double inv[N * N] = {};
+			for (int i = 0; i < N * N; ++i)
+				a[i] = static_cast<double>(data[i]);
+			for (int i = 0; i < N; ++i)
+				inv[i * N + i] = 1.0;
+
+			double norm = 0.0;
+			for (int i = 0; i < N; ++i) {
+				double rowSum = 0.0;
+				for (int j = 0; j < N; ++j)
+					rowSum += absolute(a[i * N + j]);
+				if (rowSum > norm)
+					norm = rowSum;
+			}
+			const double tolerance = N * std::numeric_limits<double>::epsilon() * norm;
+
+			for (int k = 0; k < N; ++k) {
+				int pivot = k;
+				for (int i = k + 1; i < N; ++i)
+					if (absolute(a[i * N + k]) > absolute(a[pivot * N + k]))
+						pivot = i;
+				if (!(absolute(a[pivot * N + k]) > tolerance))
+					MATRIX_THROW(MyLogicError("Matrix is singular and cannot be inverted"));
+				if (pivot != k) {
+					for (int j = 0; j < N; ++j) {
+						double t = a[k * N + j];
+						a[k * N + j] = a[pivot * N + j];
+						a[pivot * N + j] = t;
+						t = inv[k * N + j];
+						inv[k * N + j] = inv[pivot * N + j];
+						inv[pivot * N + j] = t;
+					}
+				}
+				double diagonal = a[k * N + k];
+				for (int j = 0; j < N; ++j) {
+					a[k * N + j] /= diagonal;
+					inv[k * N + j] /= diagonal;
+				}
+				for (int i = 0; i < N; ++i) {
+					double factor = a[i * N + k];
+					if (i == k || factor == 0.0) continue;
+					for (int j = 0; j < N; ++j) {
+						a[i * N + j] -= factor * a[k * N + j];
+						inv[i * N + j] -= factor * inv[k * N + j];
+					}
+				}
+			}
+
+			FixedSquareMatrix result;
+			for (int i = 0; i < N * N; ++i)
+				result.data[i] = static_cast<T>(inv[i]);
+			return result;
+		}
+
+	public:
+		// === Constructors ===
+
+		/**
+		 * @brief Constructs the zero matrix.
+		 */
+		constexpr FixedSquareMatrix() : data{} {}
+
+		/**
+		 * @brief Constructs a matrix from its rows, e.g. `{{1, 2}, {3, 4}}`.
+		 * @throws MyLogicError unless there are N rows of N values.
+		 */
+		constexpr FixedSquareMatrix(std::initializer_list<std::initializer_list<T>> rows) : data{} {
+			if (static_cast<int>(rows.size()) != N)
+				MATRIX_THROW(MyLogicError("FixedSquareMatrix needs exactly N rows"));
+			int i = 0;
+			for (const std::initializer_list<T>& row : rows) {
+				if (static_cast<int>(row.size()) != N)
+					MATRIX_THROW(MyLogicError("FixedSquareMatrix rows need exactly N values"));
+				int j = 0;
+				for (T value : row)
+					data[i * N + j++] = value;
+				++i;
+			}
+		}
+
+		static constexpr FixedSquareMatrix identity() {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N; ++i)
+				result.data[i * N + i] = T(1);
+			return result;
+		}
+
+		// === Element Access ===
+
+		/**
+		 * @throws MyOutOfRange if an index is out of range.
+		 */
+		constexpr T get(int row, int col) const {
+			checkIndex(row, col);
+			return data[row * N + col];
+		}
+
+		/**
+		 * @throws MyOutOfRange if an index is out of range.
+		 */
+		constexpr void set(int row, int col, T value) {
+			checkIndex(row, col);
+			data[row * N + col] = value;
+		}
+
+		static constexpr int getSize() { return N; }
+
+		/**
+		 * @brief Copies the elements into a (heap-backed) SquareMatrix.
+		 */
+		BasicSquareMatrix<T> toSquareMatrix() const {
+			BasicSquareMatrix<T> result(N);
+			for (int i = 0; i < N; ++i) {
+				VectorGM::BasicCell<T>* row = result[i].cells();
+				for (int j = 0; j < N; ++j) {
+					row[j].value = data[i * N + j];
+					row[j].initialized = true;
+				}
+			}
+			return result;
+		}
+
+		// === Arithmetic Operators ===
+
+		constexpr FixedSquareMatrix operator+(const FixedSquareMatrix& other) const {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N * N; ++i)
+				result.data[i] = data[i] + other.data[i];
+			return result;
+		}
+
+		constexpr FixedSquareMatrix operator-(const FixedSquareMatrix& other) const {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N * N; ++i)
+				result.data[i] = data[i] - other.data[i];
+			return result;
+		}
+
+		constexpr FixedSquareMatrix operator*(T scalar) const {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N * N; ++i)
+				result.data[i] = data[i] * scalar;
+			return result;
+		}
+
+		/**
+		 * @brief Matrix product, i-k-j order so the inner loop walks rows of both operands.
+		 */
+		constexpr FixedSquareMatrix operator*(const FixedSquareMatrix& other) const {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N; ++i)
+				for (int k = 0; k < N; ++k) {
+					T a = data[i * N + k];
+					for (int j = 0; j < N; ++j)
+						result.data[i * N + j] += a * other.data[k * N + j];
+				}
+			return result;
+		}
+
+		/**
+		 * @brief Exponentiation by squaring; negative powers use the inverse.
+		 * @throws MyLogicError if the power is negative and the matrix is singular or T is
+		 *         not a floating-point type.
+		 */
+		constexpr FixedSquareMatrix operator^(int power) const {
+			if (power < 0 && !std::is_floating_point<T>::value)
+				MATRIX_THROW(MyLogicError("Negative powers require a floating-point element type"));
+			FixedSquareMatrix result = identity();
+			unsigned int exponent = power < 0 ? 0u - static_cast<unsigned int>(power)
+			                                  : static_cast<unsigned int>(power);
+			FixedSquareMatrix base = power < 0 ? inverse() : *this;
+			while (exponent > 0) {
+				if (exponent % 2 == 1)
+					result = result * base;
+				exponent /= 2;
+				if (exponent > 0)
+					base = base * base;
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Returns the transpose (this matrix is unchanged).
+		 */
+		constexpr FixedSquareMatrix operator~() const {
+			FixedSquareMatrix result;
+			for (int i = 0; i < N; ++i)
+				for (int j = 0; j < N; ++j)
+					result.data[j * N + i] = data[i * N + j];
+			return result;
+		}
+
+		/**
+		 * @brief Determinant: cofactors up to 3x3, then partial pivoting (floating point) or Bareiss (integers).
+		 */
+		constexpr T operator!() const {
+			const T* m = data;
+			if constexpr (N == 1) return m[0];
+			if constexpr (N == 2) return m[0] * m[3] - m[1] * m[2];
+			if constexpr (N == 3)
+				return m[0] * (m[4] * m[8] - m[5] * m[7])
+				     - m[1] * (m[3] * m[8] - m[5] * m[6])
+				     + m[2] * (m[3] * m[7] - m[4] * m[6]);
+
+			T a[N * N] = {};
+			for (int i = 0; i < N * N; ++i)
+				a[i] = data[i];
+			bool negate = false;
+			if constexpr (std::is_floating_point<T>::value) {
+				T det = T(1);
+				for (int k = 0; k < N; ++k) {
+					int pivot = k;
+					for (int i = k + 1; i < N; ++i)
+						if (absolute(a[i * N + k]) > absolute(a[pivot * N + k]))
+							pivot = i;
+					if (a[pivot * N + k] == T())
+						return T();
+					if (pivot != k) {
+						for (int j = k; j < N; ++j) {
+							T t = a[k * N + j];
+							a[k * N + j] = a[pivot * N + j];
+							a[pivot * N + j] = t;
+						}
+						negate = !negate;
+					}
+					T diagonal = a[k * N + k];
+					det *= diagonal;
+					for (int i = k + 1; i < N; ++i) {
+						T factor = a[i * N + k] / diagonal;
+						for (int j = k + 1; j < N; ++j)
+							a[i * N + j] -= factor * a[k * N + j];
+					}
+				}
+				return negate ? -det : det;
+			} else {
+				T previous = T(1);
+				for (int k = 0; k < N - 1; ++k) {
+					if (a[k * N + k] == T()) {
+						int pivot = k + 1;
+						while (pivot < N && a[pivot * N + k] == T())
+							++pivot;
+						if (pivot == N)
+							return T();
+						for (int j = k; j < N; ++j) {
+							T t = a[k * N + j];
+							a[k * N + j] = a[pivot * N + j];
+							a[pivot * N + j] = t;
+						}
+						negate = !negate;
+					}
+					for (int i = k + 1; i < N; ++i)
+						for (int j = k + 1; j < N; ++j)
+							a[i * N + j] = (a[i * N + j] * a[k * N + k] - a[i * N + k] * a[k * N + j]) / previous;
+					previous = a[k * N + k];
+				}
+				T det = a[N * N - 1];
+				return negate ? -det : det;
+			}
+		}
+
+		// === Comparison ===
+
+		constexpr bool operator==(const FixedSquareMatrix& other) const {
+			for (int i = 0; i < N * N; ++i)
+				if (data[i] != other.data[i])
+					return false;
+			return true;
+		}
+
+		constexpr bool operator!=(const FixedSquareMatrix& other) const {
+			return !(*this == other);
+		}
+
+		// === Output Operator ===
+
+		friend std::ostream& operator<<(std::ostream& os, const FixedSquareMatrix& mat) {
+			for (int i = 0; i < N; ++i) {
+				for (int j = 0; j < N; ++j)
+					os << mat.data[i * N + j] << " ";
+				os << '\n';
+			}
+			return os;
+		}
+	};
+
+} // namespace SquareMatrixGM
+
+#endif
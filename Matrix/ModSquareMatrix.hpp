@@ -0,0 +1,309 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Definition of the ModSquareMatrix class template for exact arithmetic modulo a prime.
+ *
+ * SquareMatrix stores doubles, so `operator%` and `operator^` lose precision long before
+ * the modulus is applied. ModSquareMatrix<P> instead stores every element as an exact
+ * uint64_t residue in Montgomery form (x * 2^64 mod P), so that a modular product costs
+ * one 128-bit multiply and one Montgomery reduction instead of a 128-bit division.
+ *
+ * Matrix multiplication uses lazy reduction: each output element accumulates the raw
+ * 128-bit products, unreduced, for as many terms as 2^128 / P^2 allows (the whole row
+ * for P < 2^32), folds the accumulator back below P * 2^64 only between such runs, and
+ * performs a single Montgomery reduction at the end. The inner loop has no branch. Together with exponentiation by
+ * squaring, this computes A^k for k up to 2^64 - 1 in O(n^3 log k) exact operations.
+ *
+ * Buffers come from MemoryGM::allocateArray, so they count towards memoryStats() and the
+ * memory budget like the cells of SquareMatrix.
+ *
+ * Requirements: P must be odd and 2 < P < 2^63. The class is header-only because the
+ * modulus is a template parameter; it relies on the `unsigned __int128` extension of
+ * GCC and Clang.
+ */
+
+#ifndef MOD_SQUARE_MATRIX_HPP
+#define MOD_SQUARE_MATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include "SquareMatrix.hpp"
+#include "../Exception/MyExceptions.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Test_And_Log/Logger.hpp"
+
+namespace SquareMatrixGM {
+
+	/**
+	 * @class ModSquareMatrix
+	 * @brief A square matrix over the integers modulo P with Montgomery arithmetic.
+	 * @tparam P The odd modulus, 2 < P < 2^63.
+	 */
+	template <uint64_t P>
+	class ModSquareMatrix {
+		static_assert(P % 2 == 1 && P > 2, "ModSquareMatrix modulus must be odd and greater than 2");
+		static_assert(P < (1ULL << 63), "ModSquareMatrix modulus must be below 2^63");
+
+		using u128 = unsigned __int128;
+
+	private:
+		uint64_t* data; ///< size * size residues in Montgomery form, row-major
+		int size;       ///< Size of the square matrix (NxN)
+
+		/**
+		 * @brief -P^-1 mod 2^64, by Newton iteration (each step doubles the correct bits).
+		 */
+		static constexpr uint64_t negInverse() {
+			uint64_t inv = P;
+			for (int i = 0; i < 6; ++i)
+				inv *= 2 - P * inv;
+			return 0 - inv;
+		}
+
+		static constexpr uint64_t NEG_INV = negInverse();
+		static constexpr uint64_t R1 = (0 - P) % P; ///< 2^64 mod P
+		static constexpr uint64_t R2 = static_cast<uint64_t>((static_cast<u128>(R1) * R1) % P); ///< 2^128 mod P
+		static constexpr u128 P_SHIFTED = static_cast<u128>(P) << 64; ///< P * 2^64, the REDC input bound
+
+		/**
+		 * @brief Products of two residues that fit in an accumulator folded below P * 2^64.
+		 */
+		static constexpr u128 lazyTerms() {
+			u128 square = static_cast<u128>(P - 1) * (P - 1);
+			return (~static_cast<u128>(0) - (P_SHIFTED - 1)) / square;
+		}
+
+		static constexpr int LAZY_TERMS = lazyTerms() > 0x7fffffff ? 0x7fffffff : static_cast<int>(lazyTerms());
+
+		/**
+		 * @brief Congruent value below P * 2^64: only the high word is reduced, so REDC accepts it.
+		 */
+		static u128 fold(u128 t) {
+			uint64_t high = static_cast<uint64_t>(t >> 64) % P;
+			return (static_cast<u128>(high) << 64) | static_cast<uint64_t>(t);
+		}
+
+		/**
+		 * @brief Montgomery reduction: returns t * 2^-64 mod P for t < P * 2^64.
+		 */
+		static uint64_t reduce(u128 t) {
+			uint64_t m = static_cast<uint64_t>(t) * NEG_INV;
+			uint64_t u = static_cast<uint64_t>((t + static_cast<u128>(m) * P) >> 64);
+			return u >= P ? u - P : u;
+		}
+
+		static uint64_t toMontgomery(uint64_t value) { return reduce(static_cast<u128>(value % P) * R2); }
+		static uint64_t fromMontgomery(uint64_t value) { return reduce(value); }
+
+		static ModSquareMatrix identity(int size) {
+			ModSquareMatrix result(size);
+			for (int i = 0; i < size; ++i)
+				result.data[result.index(i, i)] = R1;
+			return result;
+		}
+
+		std::size_t index(int row, int col) const { return static_cast<std::size_t>(row) * size + col; }
+		std::size_t elements() const { return static_cast<std::size_t>(size) * size; }
+
+		void checkIndex(int row, int col) const {
+			if (row < 0 || row >= size || col < 0 || col >= size)
+				MATRIX_THROW(MyOutOfRange());
+		}
+
+	public:
+		// === Constructors and Destructor ===
+
+		/**
+		 * @brief Constructs a zero matrix of given size.
+		 * @throws InvalidArgument if size is negative.
+		 */
+		ModSquareMatrix(int size) : size(size) {
+			if (size < 0)
+				MATRIX_THROW(InvalidArgument());
+			LOG(LogLevel::DEBUG, "ModSquareMatrix constructor called with size = " << size);
+			data = MemoryGM::allocateArray<uint64_t>(elements());
+			for (std::size_t i = 0; i < elements(); ++i)
+				data[i] = 0;
+		}
+
+		/**
+		 * @brief Reduces a fully initialized integer matrix modulo P (negative values wrap around).
+		 * @throws MyLogicError if the matrix is not fully initialized.
+		 */
+		explicit ModSquareMatrix(const BasicSquareMatrix<int64_t>& matrix) : ModSquareMatrix(matrix.getSize()) {
+			for (int i = 0; i < size; ++i) {
+				const VectorGM::BasicVector<int64_t>& row = matrix[i];
+				if (!row.allInitialized())
+					MATRIX_THROW(MyLogicError("Matrix must be fully initialized to reduce modulo P"));
+				for (int j = 0; j < size; ++j)
+					set(i, j, row[j] < 0 ? P - (static_cast<uint64_t>(-(row[j] + 1)) % P + 1) % P
+					                     : static_cast<uint64_t>(row[j]));
+			}
+		}
+
+		ModSquareMatrix(const ModSquareMatrix& other) : size(other.size) {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix copy constructor called");
+			data = MemoryGM::allocateArray<uint64_t>(elements());
+			for (std::size_t i = 0; i < elements(); ++i)
+				data[i] = other.data[i];
+		}
+
+		ModSquareMatrix& operator=(const ModSquareMatrix& other) {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix assignment operator called");
+			if (this == &other) return *this;
+			uint64_t* copy = MemoryGM::allocateArray<uint64_t>(other.elements());
+			for (std::size_t i = 0; i < other.elements(); ++i)
+				copy[i] = other.data[i];
+			MemoryGM::releaseArray(data, elements());
+			data = copy;
+			size = other.size;
+			return *this;
+		}
+
+		/// Takes the residues over; `other` is left empty.
+		ModSquareMatrix(ModSquareMatrix&& other) noexcept : data(other.data), size(other.size) {
+			other.data = nullptr;
+			other.size = 0;
+		}
+
+		ModSquareMatrix& operator=(ModSquareMatrix&& other) noexcept {
+			std::swap(data, other.data);
+			std::swap(size, other.size);
+			return *this;
+		}
+
+		~ModSquareMatrix() {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix destructor called");
+			MemoryGM::releaseArray(data, elements());
+		}
+
+		// === Element Access ===
+
+		/**
+		 * @brief Returns element (row, col) as a residue in [0, P).
+		 * @throws MyOutOfRange if an index is out of range.
+		 */
+		uint64_t get(int row, int col) const {
+			checkIndex(row, col);
+			return fromMontgomery(data[index(row, col)]);
+		}
+
+		/**
+		 * @brief Stores `value mod P` at (row, col).
+		 * @throws MyOutOfRange if an index is out of range.
+		 */
+		void set(int row, int col, uint64_t value) {
+			checkIndex(row, col);
+			data[index(row, col)] = toMontgomery(value);
+		}
+
+		int getSize() const { return size; }
+		static constexpr uint64_t modulus() { return P; }
+
+		// === Arithmetic Operators ===
+
+		ModSquareMatrix operator+(const ModSquareMatrix& other) const {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix operator+ called");
+			if (size != other.size)
+				MATRIX_THROW(MyLogicError("Matrix sizes must match for addition"));
+			ModSquareMatrix result(size);
+			for (std::size_t i = 0; i < elements(); ++i) {
+				uint64_t s = data[i] + other.data[i];
+				result.data[i] = s >= P ? s - P : s;
+			}
+			return result;
+		}
+
+		ModSquareMatrix operator-(const ModSquareMatrix& other) const {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix operator- called");
+			if (size != other.size)
+				MATRIX_THROW(MyLogicError("Matrix sizes must match for subtraction"));
+			ModSquareMatrix result(size);
+			for (std::size_t i = 0; i < elements(); ++i)
+				result.data[i] = data[i] >= other.data[i] ? data[i] - other.data[i] : data[i] + P - other.data[i];
+			return result;
+		}
+
+		/**
+		 * @brief Modular matrix product with lazy reduction (one Montgomery reduction per element).
+		 *
+		 * The k loop runs in chunks of LAZY_TERMS; within a chunk the accumulators only add,
+		 * and between chunks they are folded below P * 2^64.
+		 */
+		ModSquareMatrix operator*(const ModSquareMatrix& other) const {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix operator* called");
+			if (size != other.size)
+				MATRIX_THROW(MyLogicError("Matrix sizes must match for multiplication"));
+			ModSquareMatrix result(size);
+			MemoryGM::ScratchArray<u128> acc(static_cast<std::size_t>(size));
+			for (int i = 0; i < size; ++i) {
+				for (int j = 0; j < size; ++j)
+					acc[j] = 0;
+				const uint64_t* rowA = data + index(i, 0);
+				for (int k0 = 0; k0 < size; k0 += LAZY_TERMS) {
+					int k1 = size - k0 > LAZY_TERMS ? k0 + LAZY_TERMS : size;
+					if (k0 > 0)
+						for (int j = 0; j < size; ++j)
+							acc[j] = fold(acc[j]);
+					for (int k = k0; k < k1; ++k) {
+						u128 a = rowA[k];
+						if (a == 0) continue;
+						const uint64_t* rowB = other.data + index(k, 0);
+						for (int j = 0; j < size; ++j)
+							acc[j] += a * rowB[j];
+					}
+				}
+				uint64_t* out = result.data + index(i, 0);
+				for (int j = 0; j < size; ++j)
+					out[j] = reduce(fold(acc[j]));
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Exponentiation by squaring, exact for any exponent below 2^64.
+		 */
+		ModSquareMatrix operator^(uint64_t power) const {
+			LOG(LogLevel::DEBUG, "ModSquareMatrix operator^ called with power = " << power);
+			ModSquareMatrix result = identity(size);
+			ModSquareMatrix base = *this;
+			while (power > 0) {
+				if (power & 1)
+					result = result * base;
+				power >>= 1;
+				if (power > 0)
+					base = base * base;
+			}
+			return result;
+		}
+
+		bool operator==(const ModSquareMatrix& other) const {
+			if (size != other.size)
+				return false;
+			for (std::size_t i = 0; i < elements(); ++i)
+				if (data[i] != other.data[i])
+					return false;
+			return true;
+		}
+
+		bool operator!=(const ModSquareMatrix& other) const {
+			return !(*this == other);
+		}
+
+		// === Output Operator ===
+
+		friend std::ostream& operator<<(std::ostream& os, const ModSquareMatrix& mat) {
+			for (int i = 0; i < mat.size; ++i) {
+				for (int j = 0; j < mat.size; ++j)
+					os << mat.get(i, j) << " ";
+				os << '\n';
+			}
+			return os;
+		}
+	};
+
+} // namespace SquareMatrixGM
+
+#endif
@@ -16,9 +16,19 @@
 
 
 #include "SquareMatrix.hpp"
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <new>
+#include <utility>
 #include "../Exception/MyExceptions.hpp"
 #include "../Test_And_Log/Logger.hpp"
+#include "../Parallel/TaskScheduler.hpp"
+#include "../Memory/HugePages.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Profiling/PerfCounters.hpp"
+#include "../Vector/Reduction.hpp"
 
 
 
@@ -26,282 +36,1441 @@ using namespace VectorGM;
 
 namespace SquareMatrixGM {
 
-    SquareMatrix::SquareMatrix(int size) : size(size) {
+    namespace {
+        /// Row loops over at least this many rows run on the shared work-stealing scheduler.
+        const int PARALLEL_MIN_ROWS = 64;
+
+        /// Smallest number of elements worth a task of its own.
+        const int MIN_TASK_ELEMENTS = 4096;
+
+        bool runsParallel(ParallelGM::Execution execution, int rows) {
+            switch (execution) {
+                case ParallelGM::Execution::Sequential:
+                    return false;
+                case ParallelGM::Execution::Automatic:
+                    return rows >= PARALLEL_MIN_ROWS;
+                default:
+                    return rows > 1;
+            }
+        }
+
+        /// Element bytes of `passes` sweeps over an n x n matrix, for the performance counters.
+        template <typename T>
+        uint64_t sweepBytes(int n, int passes) {
+            return static_cast<uint64_t>(passes) * n * n * sizeof(VectorGM::BasicCell<T>);
+        }
+
+        inline uint64_t elementCount(int n) { return static_cast<uint64_t>(n) * n; }
+        inline uint64_t cubed(int n) { return static_cast<uint64_t>(n) * n * n; }
+
+        constexpr int MULTI_VECTOR_PANEL = 8; ///< Right-hand sides multiplied together by multiplyVectors()
+        constexpr int COLUMN_BLOCK = 256; ///< Columns per tile of multiplyInto(): a tile of 8 packed double vectors is 16 KB, in L1
+        constexpr int ROW_BLOCK = 32; ///< Rows per tile of multiplyInto(); their column segments (128 KB of cells) stay in L2
+        constexpr int OUTPUT_RANGE = 128; ///< Outputs per task of the transposed matrix-vector kernel
+        constexpr int TRANSPOSE_TILE = 32; ///< Rows and columns per tile of transposeInto()
+
+        /// Rows per task: the scheduler's grain, but never fewer than MIN_TASK_ELEMENTS elements.
+        int rowGrain(int rows) {
+            int grain = ParallelGM::TaskScheduler::instance().autoGrain(rows);
+            int minimum = (MIN_TASK_ELEMENTS + rows - 1) / rows;
+            return grain > minimum ? grain : minimum;
+        }
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>::BasicSquareMatrix(int size, ParallelGM::NumaPlacement placement)
+        : size(size), transposed(false), placement(placement) {
         if (size < 0)
-            throw InvalidArgument();
+            MATRIX_THROW(InvalidArgument());
         LOG(LogLevel::DEBUG, "Constructor called with size = " << size);
-        rows = new Vector[size];
-        for (int i = 0; i < size; ++i)
-            rows[i] = Vector(size);
+        checkPlacement(placement);
+        storage = allocateStorage(nullptr);
+        rows = storage->rows;
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>::BasicSquareMatrix(int size, ParallelGM::NumaPlacement placement, RowShells)
+        : size(size), transposed(false), placement(placement) {
+        storage = allocateStorage(nullptr, true);
+        rows = storage->rows;
     }
 
-    SquareMatrix::SquareMatrix(const SquareMatrix& other) : size(other.size) {
+    template <typename T>
+    BasicSquareMatrix<T>::BasicSquareMatrix(const BasicSquareMatrix& other)
+        : storage(other.share()), rows(storage->rows), size(other.size), transposed(other.transposed),
+          placement(other.placement) {
         LOG(LogLevel::DEBUG, "Copy constructor called");
-        rows = new Vector[size];
-        for (int i = 0; i < size; ++i)
-            rows[i] = other.rows[i];
     }
 
-    SquareMatrix& SquareMatrix::operator=(const SquareMatrix& other) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator=(const BasicSquareMatrix& other) {
         LOG(LogLevel::DEBUG, "Assignment operator called");
         if (this == &other) return *this;
-        delete[] rows;
+        Storage* shared = other.share();
+        release();
+        storage = shared;
+        rows = shared->rows;
         size = other.size;
-        rows = new Vector[size];
-        for (int i = 0; i < size; ++i)
-            rows[i] = other.rows[i];
+        transposed = other.transposed;
+        placement = other.placement;
         return *this;
     }
 
-    SquareMatrix::~SquareMatrix() {
+    template <typename T>
+    BasicSquareMatrix<T>::BasicSquareMatrix(BasicSquareMatrix&& other) noexcept
+        : storage(other.storage), rows(other.rows), size(other.size), transposed(other.transposed),
+          placement(other.placement) {
+        other.storage = nullptr;
+        other.rows = nullptr;
+        other.size = 0;
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator=(BasicSquareMatrix&& other) noexcept {
+        std::swap(storage, other.storage);
+        std::swap(rows, other.rows);
+        std::swap(size, other.size);
+        std::swap(transposed, other.transposed);
+        std::swap(placement, other.placement);
+        return *this;
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>::~BasicSquareMatrix() {
         LOG(LogLevel::DEBUG, "Destructor called");
-        delete[] rows;
+        release();
+    }
+
+   /**
+ * @brief Drops this matrix's reference to its rows, freeing them with the last reference.
+ * A moved-from matrix holds none.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::release() {
+        if (storage && storage->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete[] storage->rows;
+            MemoryGM::releaseArray(storage->columns.load(std::memory_order_relaxed), static_cast<std::size_t>(size));
+            MemoryGM::deallocate(storage->slab, slabBytes());
+            delete storage;
+            MemoryGM::recordRelease(rowArrayBytes());
+        }
+    }
+
+   /**
+ * @brief Invalidates the cached sum after cells were written without the Vector API.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::noteWrite() const {
+        storage->version.fetch_add(1, std::memory_order_relaxed);
+    }
+
+   /**
+ * @brief Makes the rows exclusively owned by this matrix before they are modified.
+ *
+ * Copies share their rows (copy-on-write); the first write through a mutable
+ * operator[], an in-place operator or a layout change lands here and copies the
+ * rows only if another matrix still references them.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::detach() const {
+        if (storage->refCount.load(std::memory_order_acquire) == 1)
+            return;
+        LOG(LogLevel::DEBUG, "Detaching shared rows");
+        relocate();
+    }
+
+   /**
+ * @brief The storage a new copy of this matrix uses: these rows, with one more reference.
+ * Mutable row access goes through RowReference, which detaches before each write, so no
+ * reference into shared rows is ever written.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::Storage* BasicSquareMatrix<T>::share() const {
+        storage->refCount.fetch_add(1, std::memory_order_relaxed);
+        return storage;
+    }
+
+   /**
+ * @brief Row `row` for a write through RowReference: a transposed layout is materialized
+ * and shared rows are detached first, so the write reaches this matrix only.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType& BasicSquareMatrix<T>::writableRow(int row) {
+        materialize();
+        detach();
+        return rows[row];
+    }
+
+   /**
+ * @brief Replaces the rows with an exclusively owned copy laid out by `placement`.
+ *
+ * Each row is copied by a worker of the node it belongs to, so its cells are
+ * allocated and first touched on that node. The copy keeps the version and the
+ * cached sum, which still describe its values.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::relocate() const {
+        TRACE_SPAN("copy rows");
+        Storage* own = allocateStorage(rows);
+        own->version.store(storage->version.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> guard(storage->cacheLock);
+            own->cachedSum = storage->cachedSum;
+            own->sumVersion = storage->sumVersion;
+            own->sumValid = storage->sumValid;
+        }
+        const_cast<BasicSquareMatrix*>(this)->release();
+        storage = own;
+        rows = own->rows;
+    }
+
+   /**
+ * @brief Allocates rows for this matrix: empty ones, or copies of `source`.
+ *
+ * When the cells reach the huge-page threshold they are carved from one 2 MiB-aligned
+ * slab, so rows that are small on their own still share huge pages. Interleaved
+ * matrices keep one buffer per row, since a huge page can only live on one node.
+ * Rows are built by forEachPlacedRow, so a placed matrix first-touches each row on its node.
+ * With `shells`, rows outside a slab are left without cells for the caller to move into.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::Storage* BasicSquareMatrix<T>::allocateStorage(const VectorType* source, bool shells) const {
+        std::size_t bytes = slabBytes();
+        VectorGM::BasicCell<T>* slab = nullptr;
+        if (size > 0 && placement.kind != ParallelGM::NumaPlacement::Kind::Interleave &&
+            bytes >= MemoryGM::hugePageThreshold())
+            slab = static_cast<VectorGM::BasicCell<T>*>(MemoryGM::allocate(bytes));
+        VectorType* fresh = nullptr;
+        MATRIX_TRY {
+            MemoryGM::recordAllocation(rowArrayBytes());
+            fresh = new VectorType[size];
+            forEachPlacedRow([&](int i) {
+                if (slab) {
+                    fresh[i].~VectorType();
+                    new (&fresh[i]) VectorType(size, slab + static_cast<std::size_t>(i) * size);
+                } else if (!source && !shells) {
+                    fresh[i] = VectorType(size);
+                }
+                if (source)
+                    fresh[i] = source[i];
+            });
+            Storage* created = new Storage{fresh, slab, {1}, {0}, {}, T(), 0, false, {nullptr}, {0}};
+            for (int i = 0; i < size; ++i)
+                fresh[i].observeWrites(&created->version);
+            return created;
+        } MATRIX_CATCH_ALL {
+            // A row that could not be allocated (for instance over the memory budget).
+            if (fresh) {
+                delete[] fresh;
+                MemoryGM::recordRelease(rowArrayBytes());
+            }
+            MemoryGM::deallocate(slab, bytes);
+            MATRIX_RETHROW;
+        }
+    }
+
+   /**
+ * @brief Rejects a placement bound to a node the scheduler's topology does not have,
+ * before any row is allocated.
+ * @throws InvalidArgument for such a node.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::checkPlacement(ParallelGM::NumaPlacement placement) {
+        if (placement.kind == ParallelGM::NumaPlacement::Kind::Bind)
+            ParallelGM::TaskScheduler::instance().numaTopology().nodeIndex(placement.node);
+    }
+
+   /**
+ * @brief Calls func(i) for every row index; for a placed matrix, on a worker of row i's node.
+ *
+ * Unplaced matrices (and schedulers without workers) run the loop on the calling thread.
+ */
+    template <typename T>
+    template <typename Func>
+    void BasicSquareMatrix<T>::forEachPlacedRow(Func func) const {
+        if (!placement.isPlaced() || size < 2) {
+            for (int i = 0; i < size; ++i)
+                func(i);
+            return;
+        }
+        ParallelGM::TaskScheduler& scheduler = ParallelGM::TaskScheduler::instance();
+        const ParallelGM::NumaTopology& topology = scheduler.numaTopology();
+        ParallelGM::parallelForNodes(scheduler, 0, size,
+                                     [&](int i) { return placement.nodeOfRow(i, size, topology); }, func);
     }
 
-    Vector& SquareMatrix::operator[](int row) {
+    template <typename T>
+    typename BasicSquareMatrix<T>::RowReference BasicSquareMatrix<T>::operator[](int row) {
         LOG(LogLevel::DEBUG, "Mutable access to row " << row);
         if (row < 0 || row >= size)
-            throw MyOutOfRow();
-        return rows[row];
+            MATRIX_THROW(MyOutOfRow());
+        return RowReference(*this, row);
     }
 
-    const Vector& SquareMatrix::operator[](int row) const {
+    template <typename T>
+    const typename BasicSquareMatrix<T>::VectorType& BasicSquareMatrix<T>::operator[](int row) const {
         LOG(LogLevel::DEBUG, "Const access to row " << row);
         if (row < 0 || row >= size)
-            throw MyOutOfRow();
-        return rows[row];
+            MATRIX_THROW(MyOutOfRow());
+        if (!transposed)
+            return rows[row];
+        // The logical row is a physical column: read it from the transposed copy. A stale
+        // copy is rebuilt outside the lock (transposeInto may run on the scheduler, whose
+        // helping threads could come back here) and swapped into the published rows under
+        // it, so earlier references stay valid.
+        Storage& shared = *storage;
+        uint64_t version = shared.version.load(std::memory_order_acquire);
+        VectorType* columns = shared.columns.load(std::memory_order_acquire);
+        if (columns && shared.columnsVersion.load(std::memory_order_acquire) == version)
+            return columns[row];
+        VectorType* fresh = MemoryGM::allocateArray<VectorType>(static_cast<std::size_t>(size));
+        MATRIX_TRY {
+            transposeInto(fresh);
+        } MATRIX_CATCH_ALL {
+            MemoryGM::releaseArray(fresh, static_cast<std::size_t>(size));
+            MATRIX_RETHROW;
+        }
+        {
+            std::lock_guard<std::mutex> guard(shared.cacheLock);
+            columns = shared.columns.load(std::memory_order_relaxed);
+            if (!columns) {
+                columns = fresh;
+                fresh = nullptr;
+                shared.columns.store(columns, std::memory_order_release);
+                shared.columnsVersion.store(version, std::memory_order_release);
+            } else if (shared.columnsVersion.load(std::memory_order_relaxed) != version) {
+                for (int j = 0; j < size; ++j)
+                    std::swap(columns[j], fresh[j]);
+                shared.columnsVersion.store(version, std::memory_order_release);
+            }
+        }
+        MemoryGM::releaseArray(fresh, static_cast<std::size_t>(size));
+        return columns[row];
     }
 
 
 
-    int SquareMatrix::getSize() const {
+    template <typename T>
+    int BasicSquareMatrix<T>::getSize() const {
         LOG(LogLevel::DEBUG, "getSize() called");
         return size;
     }
 
-    SquareMatrix SquareMatrix::operator+(const SquareMatrix& other) const {
+   /**
+ * @brief Bytes of this matrix: the object, its row storage and all cells. Rows shared
+ * with copies are counted in full by each of them.
+ */
+    template <typename T>
+    std::size_t BasicSquareMatrix<T>::footprint() const {
+        return sizeof(*this) + rowArrayBytes() + slabBytes();
+    }
+
+    template <typename T>
+    std::size_t BasicSquareMatrix<T>::slabBytes() const {
+        return sizeof(VectorGM::BasicCell<T>) * static_cast<std::size_t>(size) * size;
+    }
+
+    template <typename T>
+    std::size_t BasicSquareMatrix<T>::rowArrayBytes() const {
+        return sizeof(Storage) + sizeof(VectorType) * static_cast<std::size_t>(size);
+    }
+
+   /**
+ * @brief Moves the rows to the nodes chosen by a new placement.
+ *
+ * The rows are copied into a fresh array by node-affine workers (which also detaches
+ * shared rows); values, layout and the cached sum are unchanged.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::setPlacement(ParallelGM::NumaPlacement placement) {
+        LOG(LogLevel::DEBUG, "setPlacement() called");
+        if (placement == this->placement)
+            return;
+        checkPlacement(placement);
+        this->placement = placement;
+        relocate();
+    }
+
+    template <typename T>
+    ParallelGM::NumaPlacement BasicSquareMatrix<T>::getPlacement() const {
+        return placement;
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator+(const BasicSquareMatrix& other) const {
         LOG(LogLevel::DEBUG, "operator+ called");
+        return plus(ParallelGM::Execution::Automatic, other);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::plus(ParallelGM::Execution execution, const BasicSquareMatrix& other) const {
+        PROFILE_OPERATION(MatrixAdd, sweepBytes<T>(size, 3), elementCount(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for addition");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row + other[i];
-        });
-        return result;
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for addition"));
+        return mapRows(execution, &other,
+                       [](const VectorType& a, const VectorType& b) { return a + b; },
+                       [](T a, T b) { return a + b; },
+                       "Both vectors must be fully initialized for addition");
     }
 
-    SquareMatrix& SquareMatrix::operator+=(const SquareMatrix& other) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator+=(const BasicSquareMatrix& other) {
         LOG(LogLevel::DEBUG, "operator+= called");
+        return addAssign(ParallelGM::Execution::Automatic, other);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::addAssign(ParallelGM::Execution execution, const BasicSquareMatrix& other) {
+        PROFILE_OPERATION(MatrixAddAssign, sweepBytes<T>(size, 3), elementCount(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for addition");
-        forEachRow([&](int i, Vector& row) {
-            row += other[i];
-        });
-        return *this;
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for addition"));
+        return updateRows(execution, &other,
+                          [](VectorType& row, const VectorType& b) { row += b; },
+                          [](T a, T b) { return a + b; },
+                          nullptr);
     }
 
-    SquareMatrix SquareMatrix::operator-(const SquareMatrix& other) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator-(const BasicSquareMatrix& other) const {
         LOG(LogLevel::DEBUG, "operator- called");
+        return minus(ParallelGM::Execution::Automatic, other);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::minus(ParallelGM::Execution execution, const BasicSquareMatrix& other) const {
+        PROFILE_OPERATION(MatrixSubtract, sweepBytes<T>(size, 3), elementCount(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for subtraction");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row - other[i];
-        });
-        return result;
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for subtraction"));
+        return mapRows(execution, &other,
+                       [](const VectorType& a, const VectorType& b) { return a - b; },
+                       [](T a, T b) { return a - b; },
+                       "Both vectors must be fully initialized for subtraction");
     }
 
-    SquareMatrix& SquareMatrix::operator-=(const SquareMatrix& other) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator-=(const BasicSquareMatrix& other) {
         LOG(LogLevel::DEBUG, "operator-= called");
+        return subtractAssign(ParallelGM::Execution::Automatic, other);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::subtractAssign(ParallelGM::Execution execution, const BasicSquareMatrix& other) {
+        PROFILE_OPERATION(MatrixSubtractAssign, sweepBytes<T>(size, 3), elementCount(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for subtraction");
-        forEachRow([&](int i, Vector& row) {
-            row -= other[i];
-        });
-        return *this;
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for subtraction"));
+        return updateRows(execution, &other,
+                          [](VectorType& row, const VectorType& b) { row -= b; },
+                          [](T a, T b) { return a - b; },
+                          nullptr);
     }
 
-    SquareMatrix SquareMatrix::operator*(const SquareMatrix& other) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator*(const BasicSquareMatrix& other) const {
         LOG(LogLevel::DEBUG, "operator* (matrix multiplication) called");
+        PROFILE_OPERATION(MatrixMultiply, sweepBytes<T>(size, 3), 2 * cubed(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for multiplication");
-        Vector* cols = Vector::transposeColumnsToRows(other.rows, size);
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            for (int j = 0; j < size; ++j) {
-                result[i][j] = row * cols[j];
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for multiplication"));
+        // Logical rows of the left operand and logical columns of the right one are needed
+        // as rows. A transposed operand stores the other kind, so the left one is copied
+        // transposed (never rewritten in place: both operands are const) and the right one
+        // is used as-is.
+        MemoryGM::ScratchArray<VectorType> leftRows(transposed ? size : 0);
+        if (transposed)
+            transposeInto(leftRows.get());
+        const VectorType* lhs = transposed ? leftRows.get() : rows;
+        VectorType* cols = other.rows;
+        if (!other.transposed) {
+            TRACE_SPAN("transpose columns");
+            cols = VectorType::transposeColumnsToRows(other.rows, size);
+        }
+        BasicSquareMatrix result(size, placement);
+        MATRIX_TRY {
+            TRACE_SPAN("multiply rows");
+            forEachRow([&](int i, const VectorType&) {
+                const VectorType& row = lhs[i];
+                VectorGM::BasicCell<T>* out = result.rows[i].cells(); // a fresh result: no sum to invalidate
+                for (int j = 0; j < size; ++j) {
+                    out[j].value = row * cols[j];
+                    out[j].initialized = true;
+                }
+            });
+        } MATRIX_CATCH_ALL {
+            if (cols != other.rows)
+                VectorType::releaseRows(cols, size);
+            MATRIX_RETHROW;
+        }
+        if (cols != other.rows)
+            VectorType::releaseRows(cols, size);
+        return result;
+    }
+
+   /**
+ * @brief Matrix-vector product.
+ *
+ * Each output element is the dot product of a row with the vector, computed with the
+ * multi-accumulator kernel of Reduction.hpp; rows run in parallel for large matrices.
+ * Unlike looping over rows with Vector::operator*, nothing is logged or bounds-checked
+ * per element: the operands are validated once.
+ *
+ * @throws MyLogicError if the sizes differ or an operand is not fully initialized.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::operator*(const VectorType& vector) const {
+        LOG(LogLevel::DEBUG, "operator* (matrix-vector) called");
+        PROFILE_OPERATION(MatrixVectorMultiply,
+                          sweepBytes<T>(size, 1) + 2 * sizeof(VectorGM::BasicCell<T>) * static_cast<uint64_t>(size),
+                          2 * elementCount(size));
+        VectorType result(size);
+        multiplyInto(&vector, 1, &result);
+        return result;
+    }
+
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorList BasicSquareMatrix<T>::multiplyVectors(const VectorType* vectors,
+                                                                                    int count) const {
+        LOG(LogLevel::DEBUG, "multiplyVectors() called with " << count << " vectors");
+        PROFILE_OPERATION(MatrixMultiVectorMultiply,
+                          sweepBytes<T>(size, 1) + 2 * sizeof(VectorGM::BasicCell<T>) * static_cast<uint64_t>(size)
+                              * static_cast<uint64_t>(count > 0 ? count : 0),
+                          2 * elementCount(size) * static_cast<uint64_t>(count > 0 ? count : 0));
+        if (count < 1)
+            MATRIX_THROW(MyLogicError("No vectors to multiply"));
+        VectorList results(count);
+        for (int r = 0; r < count; ++r)
+            results.vectors[r] = VectorType(size);
+        multiplyInto(vectors, count, results.vectors);
+        return results;
+    }
+
+   /**
+ * @brief Shared kernel of operator*(Vector) and multiplyVectors().
+ *
+ * A transposed matrix is read as it is: its physical row j is scaled by x[j] and added
+ * into a range of outputs per task. Otherwise the product is tiled: each task takes
+ * ROW_BLOCK rows and walks their columns in COLUMN_BLOCK segments, adding each
+ * segment's partial result into the outputs. A single vector takes the dot-product
+ * kernel per segment. Several vectors are packed once into panels of MULTI_VECTOR_PANEL
+ * interleaved columns (zero-padded), so for each row element the inner loop is a
+ * fixed-width, contiguous multiply-add over the panel that the compiler vectorizes.
+ * A panel's tile of a column segment stays in L1 while every row of the block uses it,
+ * and the block's row segments stay in L2 while every panel passes over them, so
+ * neither the vectors nor the rows are streamed from memory once per row or per panel.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::multiplyInto(const VectorType* vectors, int count, VectorType* results) const {
+        for (int r = 0; r < count; ++r) {
+            if (vectors[r].getSize() != size)
+                MATRIX_THROW(MyLogicError("Matrix and vector sizes must match for multiplication"));
+            if (!vectors[r].allInitialized())
+                MATRIX_THROW(MyLogicError("Vector must be fully initialized for matrix-vector multiplication"));
+        }
+        const char* uninitialized = "Matrix must be fully initialized for matrix-vector multiplication";
+
+        if (transposed) {
+            forEachRow([&](int, const VectorType& row) {
+                if (!row.allInitialized())
+                    MATRIX_THROW(MyLogicError(uninitialized));
+            });
+            // Logical element (i, j) is physical (j, i): y[i] = sum over j of x[j] * row j[i].
+            auto accumulate = [&](int range) {
+                int begin = range * OUTPUT_RANGE;
+                int end = begin + OUTPUT_RANGE < size ? begin + OUTPUT_RANGE : size;
+                for (int r = 0; r < count; ++r) {
+                    VectorGM::BasicCell<T>* y = results[r].cells();
+                    for (int i = begin; i < end; ++i) {
+                        y[i].value = T();
+                        y[i].initialized = true;
+                    }
+                }
+                for (int j = 0; j < size; ++j) {
+                    const VectorGM::BasicCell<T>* a = static_cast<const VectorType&>(rows[j]).cells();
+                    for (int r = 0; r < count; ++r) {
+                        T x = vectors[r].cells()[j].value;
+                        VectorGM::BasicCell<T>* y = results[r].cells();
+                        for (int i = begin; i < end; ++i)
+                            y[i].value += x * a[i].value;
+                    }
+                }
+            };
+            int ranges = (size + OUTPUT_RANGE - 1) / OUTPUT_RANGE;
+            if (runsParallel(ParallelGM::Execution::Automatic, size))
+                ParallelGM::parallelFor(0, ranges, 1, accumulate);
+            else
+                for (int range = 0; range < ranges; ++range)
+                    accumulate(range);
+            return;
+        }
+
+        const int rowBlocks = (size + ROW_BLOCK - 1) / ROW_BLOCK;
+        auto forRowBlocks = [&](const auto& body) {
+            if (runsParallel(ParallelGM::Execution::Automatic, size))
+                ParallelGM::parallelFor(0, rowBlocks, 1, body);
+            else
+                for (int block = 0; block < rowBlocks; ++block)
+                    body(block);
+        };
+        auto rowCells = [this](int i) { return static_cast<const VectorType&>(rows[i]).cells(); };
+        // A row segment is checked when its tile first loads it, so validation costs no extra pass.
+        auto checkSegments = [&](int i0, int i1, int j0, int j1) {
+            for (int i = i0; i < i1; ++i) {
+                const VectorGM::BasicCell<T>* a = rowCells(i);
+                for (int j = j0; j < j1; ++j)
+                    if (!a[j].initialized)
+                        MATRIX_THROW(MyLogicError(uninitialized));
+            }
+        };
+
+        if (count == 1) {
+            const VectorGM::BasicCell<T>* x = vectors[0].cells();
+            VectorGM::BasicCell<T>* y = results[0].cells();
+            forRowBlocks([&](int block) {
+                int i0 = block * ROW_BLOCK;
+                int i1 = i0 + ROW_BLOCK < size ? i0 + ROW_BLOCK : size;
+                for (int i = i0; i < i1; ++i) {
+                    y[i].value = T();
+                    y[i].initialized = true;
+                }
+                for (int j0 = 0; j0 < size; j0 += COLUMN_BLOCK) {
+                    int j1 = j0 + COLUMN_BLOCK < size ? j0 + COLUMN_BLOCK : size;
+                    checkSegments(i0, i1, j0, j1);
+                    for (int i = i0; i < i1; ++i)
+                        y[i].value += VectorGM::dotCells(rowCells(i) + j0, x + j0, j1 - j0);
+                }
+            });
+            return;
+        }
+
+        const int panels = (count + MULTI_VECTOR_PANEL - 1) / MULTI_VECTOR_PANEL;
+        const std::size_t panelSize = static_cast<std::size_t>(size) * MULTI_VECTOR_PANEL;
+        MemoryGM::ScratchArray<T> packed(panelSize * panels);
+        {
+            TRACE_SPAN("pack vectors");
+            for (std::size_t k = 0; k < panelSize * panels; ++k)
+                packed[k] = T();
+            for (int r = 0; r < count; ++r) {
+                const VectorGM::BasicCell<T>* x = vectors[r].cells();
+                T* panel = packed.get() + panelSize * (r / MULTI_VECTOR_PANEL) + r % MULTI_VECTOR_PANEL;
+                for (int j = 0; j < size; ++j)
+                    panel[static_cast<std::size_t>(j) * MULTI_VECTOR_PANEL] = x[j].value;
+            }
+        }
+        TRACE_SPAN("multiply rows");
+        forRowBlocks([&](int block) {
+            int i0 = block * ROW_BLOCK;
+            int i1 = i0 + ROW_BLOCK < size ? i0 + ROW_BLOCK : size;
+            for (int r = 0; r < count; ++r) {
+                VectorGM::BasicCell<T>* y = results[r].cells();
+                for (int i = i0; i < i1; ++i) {
+                    y[i].value = T();
+                    y[i].initialized = true;
+                }
+            }
+            for (int j0 = 0; j0 < size; j0 += COLUMN_BLOCK) {
+                int j1 = j0 + COLUMN_BLOCK < size ? j0 + COLUMN_BLOCK : size;
+                checkSegments(i0, i1, j0, j1);
+                for (int p = 0; p < panels; ++p) {
+                    const T* panel = packed.get() + panelSize * p;
+                    int width = count - p * MULTI_VECTOR_PANEL < MULTI_VECTOR_PANEL ? count - p * MULTI_VECTOR_PANEL
+                                                                                    : MULTI_VECTOR_PANEL;
+                    for (int i = i0; i < i1; ++i) {
+                        const VectorGM::BasicCell<T>* a = rowCells(i);
+                        T acc[MULTI_VECTOR_PANEL] = {};
+                        for (int j = j0; j < j1; ++j) {
+                            T value = a[j].value;
+                            const T* xs = panel + static_cast<std::size_t>(j) * MULTI_VECTOR_PANEL;
+                            for (int r = 0; r < MULTI_VECTOR_PANEL; ++r)
+                                acc[r] += value * xs[r];
+                        }
+                        for (int r = 0; r < width; ++r)
+                            results[p * MULTI_VECTOR_PANEL + r].cells()[i].value += acc[r];
+                    }
+                }
             }
         });
-        delete[] cols;
-        return result;
     }
 
-    SquareMatrix SquareMatrix::operator%(const SquareMatrix& other) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator%(const BasicSquareMatrix& other) const {
         LOG(LogLevel::DEBUG, "operator% (element-wise matrix) called");
+        return hadamard(ParallelGM::Execution::Automatic, other);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::hadamard(ParallelGM::Execution execution, const BasicSquareMatrix& other) const {
+        PROFILE_OPERATION(MatrixHadamard, sweepBytes<T>(size, 3), elementCount(size));
         if (size != other.size)
-            throw MyLogicError("Matrix sizes must match for element-wise multiplication");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row % other[i];
-        });
-        return result;
+            MATRIX_THROW(MyLogicError("Matrix sizes must match for element-wise multiplication"));
+        return mapRows(execution, &other,
+                       [](const VectorType& a, const VectorType& b) { return a % b; },
+                       [](T a, T b) { return a * b; },
+                       "Both vectors must be fully initialized for element-wise multiplication");
     }
 
-    SquareMatrix SquareMatrix::operator-() const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator-() const {
         LOG(LogLevel::DEBUG, "operator- (unary minus) called");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = -row;
-        });
-        return result;
+        return negated(ParallelGM::Execution::Automatic);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::negated(ParallelGM::Execution execution) const {
+        PROFILE_OPERATION(MatrixNegate, sweepBytes<T>(size, 2), elementCount(size));
+        return mapRows(execution, nullptr,
+                       [](const VectorType& a, const VectorType&) { return -a; },
+                       [](T a, T) { return -a; },
+                       "Cannot negate uninitialized cell in vector");
     }
 
-    SquareMatrix SquareMatrix::operator*(double scalar) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator*(T scalar) const {
         LOG(LogLevel::DEBUG, "operator* (scalar) called");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row * scalar;
+        PROFILE_OPERATION(MatrixScale, sweepBytes<T>(size, 2), elementCount(size));
+        BasicSquareMatrix result(size, placement, RowShells());
+        forEachRow([&](int i, const VectorType& row) {
+            result.rows[i] = row * scalar;
         });
+        result.transposed = transposed;
         return result;
     }
 
-    SquareMatrix& SquareMatrix::operator*=(double scalar) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator*=(T scalar) {
         LOG(LogLevel::DEBUG, "operator*= (scalar) called");
-        forEachRow([&](int, Vector& row) {
-            row *= scalar;
-        });
-        return *this;
+        return scaleAssign(ParallelGM::Execution::Automatic, scalar);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::scaleAssign(ParallelGM::Execution execution, T scalar) {
+        PROFILE_OPERATION(MatrixScaleAssign, sweepBytes<T>(size, 2), elementCount(size));
+        return updateRows(execution, nullptr,
+                          [scalar](VectorType& row, const VectorType&) { row *= scalar; },
+                          [scalar](T a, T) { return a * scalar; },
+                          "Cannot multiply uninitialized cell");
     }
 
-    SquareMatrix SquareMatrix::operator%(int scalar) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator%(int scalar) const {
         LOG(LogLevel::DEBUG, "operator% (scalar) called");
+        PROFILE_OPERATION(MatrixModulo, sweepBytes<T>(size, 2), elementCount(size));
         if (scalar == 0)
-            throw MyLogicError("Modulo by zero");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row % scalar;
+            MATRIX_THROW(MyLogicError("Modulo by zero"));
+        BasicSquareMatrix result(size, placement, RowShells());
+        forEachRow([&](int i, const VectorType& row) {
+            result.rows[i] = row % scalar;
         });
+        result.transposed = transposed;
         return result;
     }
 
-    SquareMatrix& SquareMatrix::operator%=(int scalar) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator%=(int scalar) {
         LOG(LogLevel::DEBUG, "operator%= (scalar) called");
+        return moduloAssign(ParallelGM::Execution::Automatic, scalar);
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::moduloAssign(ParallelGM::Execution execution, int scalar) {
+        PROFILE_OPERATION(MatrixModuloAssign, sweepBytes<T>(size, 2), elementCount(size));
         if (scalar == 0)
-            throw MyLogicError("Modulo by zero");
-        forEachRow([&](int, Vector& row) {
-            row %= scalar;
-        });
-        return *this;
+            MATRIX_THROW(MyLogicError("Modulo by zero"));
+        return updateRows(execution, nullptr,
+                          [scalar](VectorType& row, const VectorType&) { row %= scalar; },
+                          [scalar](T a, T) { return VectorGM::ElementTraits<T>::modulo(a, scalar); },
+                          "Cannot modulo uninitialized cell");
     }
 
-    SquareMatrix SquareMatrix::operator/(double scalar) const {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator/(T scalar) const {
         LOG(LogLevel::DEBUG, "operator/ called");
-        if (scalar == 0)
-            throw MyLogicError("Division by zero");
-        SquareMatrix result(size);
-        forEachRow([&](int i, const Vector& row) {
-            result[i] = row / scalar;
+        PROFILE_OPERATION(MatrixDivide, sweepBytes<T>(size, 2), elementCount(size));
+        if (scalar == T())
+            MATRIX_THROW(MyLogicError("Division by zero"));
+        BasicSquareMatrix result(size, placement, RowShells());
+        forEachRow([&](int i, const VectorType& row) {
+            result.rows[i] = row / scalar;
         });
+        result.transposed = transposed;
         return result;
     }
 
-    SquareMatrix& SquareMatrix::operator/=(double scalar) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator/=(T scalar) {
         LOG(LogLevel::DEBUG, "operator/= called");
-        if (scalar == 0)
-            throw MyLogicError("Division by zero");
-        forEachRow([&](int, Vector& row) {
-            row /= scalar;
-        });
-        return *this;
+        return divideAssign(ParallelGM::Execution::Automatic, scalar);
     }
-    SquareMatrix SquareMatrix::operator^(int power) const {
+
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::divideAssign(ParallelGM::Execution execution, T scalar) {
+        PROFILE_OPERATION(MatrixDivideAssign, sweepBytes<T>(size, 2), elementCount(size));
+        if (scalar == T())
+            MATRIX_THROW(MyLogicError("Division by zero"));
+        return updateRows(execution, nullptr,
+                          [scalar](VectorType& row, const VectorType&) { row /= scalar; },
+                          [scalar](T a, T) { return a / scalar; },
+                          "Cannot divide uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator^(int power) const {
         LOG(LogLevel::DEBUG, "operator^ called with power = " << power);
-        if (power < 0)
-            throw MyLogicError("Matrix power must be non-negative");
-        SquareMatrix result = SquareMatrix::identity(size);
+        PROFILE_OPERATION(MatrixPower, 0, 0); // charged the multiplications it runs
+        BasicSquareMatrix result = identity(size);
         if (power == 0)
             return result;
-        SquareMatrix base = *this;
-        while (power > 0) {
-            if (power % 2 == 1)
+        // A^-k == (A^-1)^k, so invert once and square as usual.
+        unsigned int exponent = power < 0 ? 0u - static_cast<unsigned int>(power)
+                                          : static_cast<unsigned int>(power);
+        BasicSquareMatrix base = power < 0 ? inverse() : *this;
+        while (exponent > 0) {
+            if (exponent % 2 == 1) {
+                TRACE_SPAN("multiply into result");
                 result = result * base;
-            base = base * base;
-            power /= 2;
+            }
+            exponent /= 2;
+            if (exponent > 0) {
+                TRACE_SPAN("square base");
+                base = base * base;
+            }
         }
         return result;
     }
 
-    SquareMatrix& SquareMatrix::operator++() {
-        forEachRow([](int, Vector& row) {
-            ++row;  
-        });
-        return *this;
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator++() {
+        return incrementAssign(ParallelGM::Execution::Automatic);
     }
 
-    SquareMatrix SquareMatrix::operator++(int) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::incrementAssign(ParallelGM::Execution execution) {
+        PROFILE_OPERATION(MatrixIncrement, sweepBytes<T>(size, 2), elementCount(size));
+        return updateRows(execution, nullptr,
+                          [](VectorType& row, const VectorType&) { ++row; },
+                          [](T a, T) { return a + T(1); },
+                          "Cannot increment uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator++(int) {
         LOG(LogLevel::DEBUG, "operator++ (postfix) called");
-        SquareMatrix temp = *this;
+        BasicSquareMatrix temp = *this;
         ++(*this);
         return temp;
     }
 
-    SquareMatrix& SquareMatrix::operator--() {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator--() {
         LOG(LogLevel::DEBUG, "operator-- (prefix) called");
-        forEachRow([](int, Vector& row) {
-            --row;
-        });
-        return *this;
+        return decrementAssign(ParallelGM::Execution::Automatic);
     }
 
-    SquareMatrix SquareMatrix::operator--(int) {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::decrementAssign(ParallelGM::Execution execution) {
+        PROFILE_OPERATION(MatrixDecrement, sweepBytes<T>(size, 2), elementCount(size));
+        return updateRows(execution, nullptr,
+                          [](VectorType& row, const VectorType&) { --row; },
+                          [](T a, T) { return a - T(1); },
+                          "Cannot decrement uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::operator--(int) {
         LOG(LogLevel::DEBUG, "operator-- (postfix) called");
-        SquareMatrix temp = *this;
+        BasicSquareMatrix temp = *this;
         --(*this);
         return temp;
     }
 
-    SquareMatrix& SquareMatrix::operator~() {
+    template <typename T>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::operator~() {
         LOG(LogLevel::DEBUG, "operator~ (transpose) called");
-        Vector* transposed = Vector::transposeColumnsToRows(rows, size);
-        delete[] rows;
-        rows = transposed;
+        PROFILE_OPERATION(MatrixTranspose, 0, 0);
+        // O(1): only the layout flag flips. Transposing permutes elements, so a cached sum stays valid.
+        transposed = !transposed;
         return *this;
     }
 
-    double SquareMatrix::operator!() const {
+   /**
+ * @brief Rewrites the physical rows so that they match the logical layout.
+ *
+ * After `operator~` the physical rows hold the logical columns. Const members read
+ * through the flag instead (directly, or from a transposed copy made by transposeInto),
+ * since rewriting the layout of a matrix other threads may be reading is a data race;
+ * only the mutable operator[] calls this. The transpose is done in place by swapping
+ * cells, so it allocates nothing and keeps the initialization state of each cell.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::materialize() {
+        if (!transposed)
+            return;
+        LOG(LogLevel::DEBUG, "Materializing transposed layout");
+        TRACE_SPAN("materialize transpose");
+        detach();
+        // Raw swaps: the values only change places, so the cached sum stays valid.
+        for (int i = 0; i < size; ++i) {
+            VectorGM::BasicCell<T>* row = rows[i].cells();
+            for (int j = i + 1; j < size; ++j)
+                std::swap(row[j], rows[j].cells()[i]);
+        }
+        transposed = false;
+    }
+
+   /**
+ * @brief Copies the physical columns of this matrix into the rows of `out`, cells with
+ * their initialization state; out[j] gets its own cells unless it already has `size`.
+ *
+ * Works tile by tile so both sides stay in cache, column tiles in parallel for large
+ * matrices. Reads only, so it may run on a matrix other threads are reading.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::transposeInto(VectorType* out) const {
+        TRACE_SPAN("transpose rows");
+        const VectorType* source = rows;
+        auto copyColumns = [&](int tile) {
+            int jBegin = tile * TRANSPOSE_TILE;
+            int jEnd = jBegin + TRANSPOSE_TILE < size ? jBegin + TRANSPOSE_TILE : size;
+            for (int j = jBegin; j < jEnd; ++j)
+                if (out[j].getSize() != size)
+                    out[j] = VectorType(size);
+            for (int iBegin = 0; iBegin < size; iBegin += TRANSPOSE_TILE) {
+                int iEnd = iBegin + TRANSPOSE_TILE < size ? iBegin + TRANSPOSE_TILE : size;
+                for (int j = jBegin; j < jEnd; ++j) {
+                    VectorGM::BasicCell<T>* column = out[j].cells();
+                    for (int i = iBegin; i < iEnd; ++i)
+                        column[i] = source[i].cells()[j];
+                }
+            }
+        };
+        int tiles = (size + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+        if (runsParallel(ParallelGM::Execution::Automatic, size))
+            ParallelGM::parallelFor(0, tiles, 1, copyColumns);
+        else
+            for (int tile = 0; tile < tiles; ++tile)
+                copyColumns(tile);
+    }
+
+   /**
+ * @brief Computes the determinant.
+ *
+ * The elements are copied once into a work array and reduced by determinant();
+ * a transposed layout is read as is, since det(A^T) = det(A).
+ *
+ * @throws MyLogicError if the matrix is not fully initialized.
+ */
+    template <typename T>
+    T BasicSquareMatrix<T>::operator!() const {
         LOG(LogLevel::DEBUG, "operator! (determinant) called");
-        int n = getSize();
-        forEachRow([](int, const Vector& row) {
-            if (!row.allInitialized())
-                throw MyLogicError("Matrix must be fully initialized to compute determinant");
-        });
-        if (n == 1) return (*this)[0][0];
-        if (n == 2) return (*this)[0][0] * (*this)[1][1] - (*this)[0][1] * (*this)[1][0];
-        double det = 0.0;
-        for (int col = 0; col < n; ++col) {
-            double sign = (col % 2 == 0) ? 1.0 : -1.0;
-            double cofactor = sign * (*this)[0][col] * getMinor(0, col);
-            det += cofactor;
+        PROFILE_OPERATION(MatrixDeterminant, sweepBytes<T>(size, 1) + elementCount(size) * sizeof(T), 2 * cubed(size) / 3);
+        int n = size;
+        T* work = nullptr;
+        {
+            TRACE_SPAN("gather cells");
+            forEachRow([](int, const VectorType& row) {
+                if (!row.allInitialized())
+                    MATRIX_THROW(MyLogicError("Matrix must be fully initialized to compute determinant"));
+            });
+            work = MemoryGM::allocateArray<T>(static_cast<std::size_t>(n) * n);
+            for (int i = 0; i < n; ++i) {
+                const VectorGM::BasicCell<T>* cells = rows[i].cells();
+                for (int j = 0; j < n; ++j)
+                    work[i * n + j] = cells[j].value;
+            }
         }
+        T det = T();
+        {
+            TRACE_SPAN("elimination");
+            det = determinant(work, n);
+        }
+        MemoryGM::releaseArray(work, static_cast<std::size_t>(n) * n);
         return det;
     }
 
-    double SquareMatrix::getMinor(int rowToRemove, int colToRemove) const {
-        LOG(LogLevel::DEBUG, "getMinor called for row = " << rowToRemove << ", col = " << colToRemove);
-        int n = getSize();
-        SquareMatrix minor(n - 1);
-        int r = 0;
+   /**
+ * @brief Determinant of a row-major n x n array, which is used as scratch space.
+ *
+ * Up to 3x3 the cofactor expansion is written out, which keeps small integer-valued
+ * determinants exact. Larger matrices are reduced in O(n^3): Gaussian elimination
+ * with partial pivoting for floating-point and complex elements, and fraction-free
+ * (Bareiss) elimination for integers so every intermediate division is exact.
+ * The rows below each pivot are updated in parallel while there are enough of them.
+ */
+    template <typename T>
+    T BasicSquareMatrix<T>::determinant(T* a, int n) {
+        if (n == 0) return T(1);
+        if (n == 1) return a[0];
+        if (n == 2) return a[0] * a[3] - a[1] * a[2];
+        if (n == 3)
+            return a[0] * (a[4] * a[8] - a[5] * a[7])
+                 - a[1] * (a[3] * a[8] - a[5] * a[6])
+                 + a[2] * (a[3] * a[7] - a[4] * a[6]);
+
+        // Each elimination step updates the rows below the pivot independently; large steps run them in parallel.
+        auto forRowsBelow = [n](int k, const auto& body) {
+            if (n - k - 1 >= PARALLEL_MIN_ROWS) {
+                ParallelGM::parallelFor(k + 1, n, rowGrain(n - k - 1), body);
+            } else {
+                for (int i = k + 1; i < n; ++i)
+                    body(i);
+            }
+        };
+        bool negate = false;
+        if constexpr (VectorGM::ElementTraits<T>::isFloatingPoint || VectorGM::ElementTraits<T>::isComplex) {
+            T det = T(1);
+            for (int k = 0; k < n; ++k) {
+                int pivot = k;
+                for (int i = k + 1; i < n; ++i)
+                    if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k]))
+                        pivot = i;
+                if (a[pivot * n + k] == T())
+                    return T();
+                if (pivot != k) {
+                    for (int j = k; j < n; ++j)
+                        std::swap(a[k * n + j], a[pivot * n + j]);
+                    negate = !negate;
+                }
+                T diagonal = a[k * n + k];
+                det *= diagonal;
+                forRowsBelow(k, [&](int i) {
+                    T factor = a[i * n + k] / diagonal;
+                    if (factor == T()) return;
+                    for (int j = k + 1; j < n; ++j)
+                        a[i * n + j] -= factor * a[k * n + j];
+                });
+            }
+            return negate ? -det : det;
+        } else {
+            T previous = T(1);
+            for (int k = 0; k < n - 1; ++k) {
+                if (a[k * n + k] == T()) {
+                    int pivot = k + 1;
+                    while (pivot < n && a[pivot * n + k] == T())
+                        ++pivot;
+                    if (pivot == n)
+                        return T();
+                    for (int j = k; j < n; ++j)
+                        std::swap(a[k * n + j], a[pivot * n + j]);
+                    negate = !negate;
+                }
+                forRowsBelow(k, [&](int i) {
+                    for (int j = k + 1; j < n; ++j)
+                        a[i * n + j] = (a[i * n + j] * a[k * n + k] - a[i * n + k] * a[k * n + j]) / previous;
+                });
+                previous = a[k * n + k];
+            }
+            T det = a[n * n - 1];
+            return negate ? -det : det;
+        }
+    }
+
+   /**
+ * @brief Computes the inverse of the matrix with blocked, in-place Gauss-Jordan elimination.
+ *
+ * The elements are copied once into a contiguous work buffer which is then reduced
+ * in place using partial (row) pivoting, so the whole inversion costs O(n^3) and
+ * needs no second augmented matrix. Row swaps on A are undone at the end as
+ * column swaps on the inverse.
+ *
+ * Columns are eliminated in panels of `blockSize`. Inside a panel each step updates
+ * the panel columns only and records its row factors; the columns outside the panel
+ * then receive all of the panel's steps at once: the pivot rows are brought up to
+ * date by a small triangular sweep, and every other row subtracts a combination of
+ * them, one independent, contiguous row update per row, run in parallel for large
+ * matrices. A pivot counts as zero when it is below n * eps * ||A||_inf, so scaling
+ * the matrix does not change whether it is found singular.
+ *
+ * @return BasicSquareMatrix The inverse matrix.
+ * @throws MyLogicError if the matrix is not fully initialized or is singular.
+ */
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::inverse() const {
+        LOG(LogLevel::DEBUG, "inverse() called");
+        PROFILE_OPERATION(MatrixInverse, sweepBytes<T>(size, 2), 2 * cubed(size));
+        const int blockSize = 32;
+        int n = size;
+        MemoryGM::ScratchArray<double> buffer = toBuffer("Matrix must be fully initialized to compute inverse");
+        double* a = buffer.get();
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double rowSum = 0.0;
+            for (int j = 0; j < n; ++j)
+                rowSum += std::abs(a[i * n + j]);
+            if (rowSum > norm)
+                norm = rowSum;
+        }
+        const double tolerance = n * std::numeric_limits<double>::epsilon() * norm;
+
+        MemoryGM::ScratchArray<int> pivots(static_cast<std::size_t>(n));
+        MemoryGM::ScratchArray<double> factors(static_cast<std::size_t>(n) * blockSize); // row i, panel step p
+        MemoryGM::ScratchArray<double> pivotRows(static_cast<std::size_t>(n) * blockSize); // panel step p, column j
+        double scales[blockSize];
+
+        for (int kb = 0; kb < n; kb += blockSize) {
+            int kend = (kb + blockSize < n) ? kb + blockSize : n;
+            int nb = kend - kb;
+            auto outsidePanel = [&](auto body) {
+                body(0, kb);
+                body(kend, n);
+            };
+
+            // Panel steps, on the panel columns only.
+            for (int k = kb; k < kend; ++k) {
+                int pivotRow = k;
+                for (int i = k + 1; i < n; ++i) {
+                    if (std::abs(a[i * n + k]) > std::abs(a[pivotRow * n + k]))
+                        pivotRow = i;
+                }
+                if (!(std::abs(a[pivotRow * n + k]) > tolerance))
+                    MATRIX_THROW(MyLogicError("Matrix is singular and cannot be inverted"));
+                pivots[k] = pivotRow;
+                if (pivotRow != k) {
+                    for (int j = 0; j < n; ++j)
+                        std::swap(a[k * n + j], a[pivotRow * n + j]);
+                    for (int p = 0; p < k - kb; ++p)
+                        std::swap(factors[k * blockSize + p], factors[pivotRow * blockSize + p]);
+                }
+
+                double* pivot = a + k * n;
+                double scale = 1.0 / pivot[k];
+                scales[k - kb] = scale;
+                pivot[k] = 1.0;
+                for (int j = kb; j < kend; ++j)
+                    pivot[j] *= scale;
+                for (int i = 0; i < n; ++i) {
+                    double* target = a + i * n;
+                    double factor = i == k ? 0.0 : target[k];
+                    factors[i * blockSize + (k - kb)] = factor;
+                    if (factor == 0.0) continue;
+                    target[k] = 0.0;
+                    for (int j = kb; j < kend; ++j)
+                        target[j] -= factor * pivot[j];
+                }
+            }
+            if (nb == n)
+                continue;
+
+            // The pivot rows as each step saw them: earlier steps of the panel applied, then scaled.
+            for (int p = 0; p < nb; ++p) {
+                double* x = pivotRows.get() + static_cast<std::size_t>(p) * n;
+                const double* row = a + (kb + p) * n;
+                const double* f = factors.get() + (kb + p) * blockSize;
+                double scale = scales[p];
+                outsidePanel([&](int begin, int end) {
+                    for (int j = begin; j < end; ++j)
+                        x[j] = row[j];
+                    for (int q = 0; q < p; ++q) {
+                        if (f[q] == 0.0) continue;
+                        const double* xq = pivotRows.get() + static_cast<std::size_t>(q) * n;
+                        for (int j = begin; j < end; ++j)
+                            x[j] -= f[q] * xq[j];
+                    }
+                    for (int j = begin; j < end; ++j)
+                        x[j] *= scale;
+                });
+            }
+
+            // Every row takes the panel's steps at once; a pivot row only the steps after its own.
+            auto update = [&](int i) {
+                double* row = a + i * n;
+                const double* f = factors.get() + i * blockSize;
+                int first = 0;
+                if (i >= kb && i < kend) {
+                    first = i - kb + 1;
+                    const double* own = pivotRows.get() + static_cast<std::size_t>(i - kb) * n;
+                    outsidePanel([&](int begin, int end) {
+                        for (int j = begin; j < end; ++j)
+                            row[j] = own[j];
+                    });
+                }
+                for (int p = first; p < nb; ++p) {
+                    if (f[p] == 0.0) continue;
+                    const double* xp = pivotRows.get() + static_cast<std::size_t>(p) * n;
+                    outsidePanel([&](int begin, int end) {
+                        for (int j = begin; j < end; ++j)
+                            row[j] -= f[p] * xp[j];
+                    });
+                }
+            };
+            if (n >= PARALLEL_MIN_ROWS) {
+                ParallelGM::parallelFor(0, n, rowGrain(n), update);
+            } else {
+                for (int i = 0; i < n; ++i)
+                    update(i);
+            }
+        }
+
+        for (int k = n - 1; k >= 0; --k) {
+            if (pivots[k] == k) continue;
+            for (int i = 0; i < n; ++i)
+                std::swap(a[i * n + k], a[i * n + pivots[k]]);
+        }
+
+        return fromBuffer(a, n);
+    }
+
+   /**
+ * @brief Computes the Cholesky factor of a symmetric positive-definite matrix.
+ *
+ * Uses a blocked right-looking algorithm on a contiguous row-major copy: each
+ * diagonal block is factored, the panel below it is solved against it (TRSM),
+ * and the trailing lower triangle is then updated in one SYRK/GEMM sweep whose
+ * inner loops are contiguous dot products. The panel solve and the trailing
+ * update write one row each, so they run by rows, in parallel for large matrices.
+ * Only the lower triangle is touched,
+ * so the work is about half of an LU and no pivoting is needed. The first
+ * non-positive pivot aborts the factorization.
+ *
+ * @return BasicSquareMatrix The lower-triangular factor L with A = L * L^T.
+ * @throws MyLogicError if the matrix is uninitialized, not symmetric or not positive definite.
+ */
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::cholesky() const {
+        LOG(LogLevel::DEBUG, "cholesky() called");
+        PROFILE_OPERATION(MatrixCholesky, sweepBytes<T>(size, 2), cubed(size) / 3);
+        const int blockSize = 64;
+        int n = size;
+        MemoryGM::ScratchArray<double> buffer = toBuffer("Matrix must be fully initialized to compute Cholesky factor");
+        double* a = buffer.get();
+
         for (int i = 0; i < n; ++i) {
-            if (i == rowToRemove) continue;
-            int c = 0;
-            for (int j = 0; j < n; ++j) {
-                if (j == colToRemove) continue;
-                minor[r][c] = (*this)[i][j];
-                ++c;
+            for (int j = 0; j < i; ++j) {
+                if (std::abs(a[i * n + j] - a[j * n + i]) > 1e-9 * (1.0 + std::abs(a[i * n + j])))
+                    MATRIX_THROW(MyLogicError("Matrix must be symmetric for Cholesky factorization"));
+            }
+        }
+        // The rows below a panel are independent; large trailing blocks split them across the workers.
+        auto forTrailingRows = [n](int begin, const auto& body) {
+            if (n - begin >= PARALLEL_MIN_ROWS) {
+                ParallelGM::parallelFor(begin, n, rowGrain(n - begin), body);
+            } else {
+                for (int i = begin; i < n; ++i)
+                    body(i);
             }
-            ++r;
+        };
+
+        for (int kb = 0; kb < n; kb += blockSize) {
+            int kend = (kb + blockSize < n) ? kb + blockSize : n;
+
+            // Diagonal block.
+            for (int j = kb; j < kend; ++j) {
+                double* rowJ = a + j * n;
+                double d = rowJ[j];
+                for (int p = kb; p < j; ++p)
+                    d -= rowJ[p] * rowJ[p];
+                if (!(d > 0.0))
+                    MATRIX_THROW(MyLogicError("Matrix is not positive definite"));
+                rowJ[j] = std::sqrt(d);
+                for (int i = j + 1; i < kend; ++i) {
+                    double* rowI = a + i * n;
+                    double v = rowI[j];
+                    for (int p = kb; p < j; ++p)
+                        v -= rowI[p] * rowJ[p];
+                    rowI[j] = v / rowJ[j];
+                }
+            }
+
+            // Panel below the diagonal block (TRSM); each row only reads the diagonal block.
+            forTrailingRows(kend, [&](int i) {
+                double* rowI = a + i * n;
+                for (int j = kb; j < kend; ++j) {
+                    const double* rowJ = a + j * n;
+                    double v = rowI[j];
+                    for (int p = kb; p < j; ++p)
+                        v -= rowI[p] * rowJ[p];
+                    rowI[j] = v / rowJ[j];
+                }
+            });
+
+            // Trailing lower triangle (SYRK on the diagonal, GEMM below it); row i writes only row i.
+            forTrailingRows(kend, [&](int i) {
+                const double* panelI = a + i * n + kb;
+                for (int j = kend; j <= i; ++j) {
+                    const double* panelJ = a + j * n + kb;
+                    double v = 0.0;
+                    for (int p = 0; p < kend - kb; ++p)
+                        v += panelI[p] * panelJ[p];
+                    a[i * n + j] -= v;
+                }
+            });
+        }
+
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+                a[i * n + j] = 0.0;
+
+        return fromBuffer(a, n);
+    }
+
+   /**
+ * @brief Computes det(A) from the Cholesky factor L of A.
+ *
+ * Since det(A) = det(L)^2 and L is triangular, this is the squared product of
+ * the diagonal of L and costs O(n).
+ *
+ * @param factor The lower-triangular factor returned by cholesky().
+ * @return T The determinant of the original matrix.
+ */
+    template <typename T>
+    T BasicSquareMatrix<T>::choleskyDeterminant(const BasicSquareMatrix& factor) {
+        LOG(LogLevel::DEBUG, "choleskyDeterminant() called");
+        MemoryGM::ScratchArray<double> l = factor.toBuffer("Cholesky factor must be fully initialized");
+        double product = 1.0;
+        for (int i = 0; i < factor.size; ++i)
+            product *= l[static_cast<std::size_t>(i) * factor.size + i];
+        return VectorGM::ElementTraits<T>::fromDouble(product * product);
+    }
+
+   /**
+ * @brief Solves A * x = rhs using the Cholesky factor L of A.
+ *
+ * Runs forward substitution with L and back substitution with L^T, O(n^2).
+ *
+ * @param factor The lower-triangular factor returned by cholesky().
+ * @param rhs The right-hand side vector.
+ * @return Vector The solution x.
+ * @throws MyLogicError if sizes do not match or rhs is not fully initialized.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::choleskySolve(const BasicSquareMatrix& factor, const VectorType& rhs) {
+        LOG(LogLevel::DEBUG, "choleskySolve() called");
+        int n = factor.size;
+        if (rhs.getSize() != n)
+            MATRIX_THROW(MyLogicError("Right-hand side size must match matrix size"));
+        if (!rhs.allInitialized())
+            MATRIX_THROW(MyLogicError("Right-hand side must be fully initialized"));
+
+        MemoryGM::ScratchArray<double> buffer = factor.toBuffer("Cholesky factor must be fully initialized");
+        const double* l = buffer.get();
+        MemoryGM::ScratchArray<double> solution(static_cast<std::size_t>(n));
+        double* x = solution.get();
+        for (int i = 0; i < n; ++i) {
+            double v = VectorGM::ElementTraits<T>::toDouble(rhs[i]);
+            for (int p = 0; p < i; ++p)
+                v -= l[i * n + p] * x[p];
+            x[i] = v / l[i * n + i];
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double v = x[i];
+            for (int p = i + 1; p < n; ++p)
+                v -= l[p * n + i] * x[p];
+            x[i] = v / l[i * n + i];
+        }
+
+        return fromDoubles(x, n);
+    }
+
+   /**
+ * @brief Creates a view of the n x n block at (row, col), writable or read-only
+ * depending on the constness of the matrix. The view shares this matrix's cells.
+ */
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrix<T>::block(int row, int col, int n) {
+        LOG(LogLevel::DEBUG, "block() called for row = " << row << ", col = " << col << ", n = " << n);
+        return BasicSquareMatrixView<T>(*this).block(row, col, n);
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrix<T>::block(int row, int col, int n) const {
+        LOG(LogLevel::DEBUG, "block() const called for row = " << row << ", col = " << col << ", n = " << n);
+        return BasicSquareMatrixView<T>(*this).block(row, col, n);
+    }
+
+   /**
+ * @brief Creates a view of the matrix without one row and one column (a minor), with no copy.
+ */
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrix<T>::minorView(int row, int col) {
+        LOG(LogLevel::DEBUG, "minorView() called for row = " << row << ", col = " << col);
+        return BasicSquareMatrixView<T>(*this).minorView(row, col);
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrix<T>::minorView(int row, int col) const {
+        LOG(LogLevel::DEBUG, "minorView() const called for row = " << row << ", col = " << col);
+        return BasicSquareMatrixView<T>(*this).minorView(row, col);
+    }
+
+   /**
+ * @brief Builds a new matrix row by row from this matrix and, optionally, `other`.
+ *
+ * Sequential and parallel policies apply `rowOp` (a Vector operator, with its checks and
+ * logging) to each row. ParallelUnsequenced runs `cellOp` over the raw cells instead: one
+ * pass checks initialization, a second computes values in a plain loop the compiler can
+ * vectorize. Sizes must already match. The result takes this matrix's layout; an `other`
+ * of the opposite layout is read from a transposed copy, as neither operand may be
+ * rewritten in place.
+ *
+ * @param uninitialized Error message for an uninitialized cell in the unsequenced kernel.
+ */
+    template <typename T>
+    template <typename RowOp, typename CellOp>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::mapRows(ParallelGM::Execution execution, const BasicSquareMatrix* other,
+                                                       RowOp rowOp, CellOp cellOp, const char* uninitialized) const {
+        bool mixed = other && other->transposed != transposed;
+        MemoryGM::ScratchArray<VectorType> flipped(mixed ? size : 0);
+        if (mixed)
+            other->transposeInto(flipped.get());
+        const VectorType* otherRows = mixed ? flipped.get() : other ? other->rows : nullptr;
+        bool unsequenced = execution == ParallelGM::Execution::ParallelUnsequenced;
+        BasicSquareMatrix result = unsequenced ? BasicSquareMatrix(size, placement)
+                                               : BasicSquareMatrix(size, placement, RowShells());
+        if (unsequenced) {
+            forEachRow(execution, [&](int i, const VectorType& row) {
+                const VectorGM::BasicCell<T>* a = row.cells();
+                const VectorGM::BasicCell<T>* b = otherRows ? otherRows[i].cells() : a;
+                VectorGM::BasicCell<T>* out = result.rows[i].cells();
+                bool initialized = true;
+                for (int j = 0; j < size; ++j)
+                    initialized &= a[j].initialized & b[j].initialized;
+                if (!initialized)
+                    MATRIX_THROW(MyLogicError(uninitialized));
+                for (int j = 0; j < size; ++j) {
+                    out[j].value = cellOp(a[j].value, b[j].value);
+                    out[j].initialized = true;
+                }
+            });
+        } else {
+            forEachRow(execution, [&](int i, const VectorType& row) {
+                result.rows[i] = rowOp(row, otherRows ? otherRows[i] : row);
+            });
+        }
+        result.transposed = transposed;
+        return result;
+    }
+
+   /**
+ * @brief Updates this matrix row by row, optionally combining it with `other`.
+ *
+ * Same policy and layout handling as mapRows. In the unsequenced kernel only this matrix's
+ * cells are checked, and only when `uninitialized` is non-null, matching the Vector operators.
+ */
+    template <typename T>
+    template <typename RowOp, typename CellOp>
+    BasicSquareMatrix<T>& BasicSquareMatrix<T>::updateRows(ParallelGM::Execution execution, const BasicSquareMatrix* other,
+                                                           RowOp rowOp, CellOp cellOp, const char* uninitialized) {
+        bool mixed = other && other->transposed != transposed;
+        MemoryGM::ScratchArray<VectorType> flipped(mixed ? size : 0);
+        if (mixed)
+            other->transposeInto(flipped.get());
+        const VectorType* otherRows = mixed ? flipped.get() : other ? other->rows : nullptr;
+        if (execution == ParallelGM::Execution::ParallelUnsequenced) {
+            forEachRow(execution, [&](int i, VectorType& row) {
+                VectorGM::BasicCell<T>* a = row.cells();
+                const VectorGM::BasicCell<T>* b = otherRows ? otherRows[i].cells() : a;
+                if (uninitialized) {
+                    bool initialized = true;
+                    for (int j = 0; j < size; ++j)
+                        initialized &= a[j].initialized;
+                    if (!initialized)
+                        MATRIX_THROW(MyLogicError(uninitialized));
+                }
+                for (int j = 0; j < size; ++j)
+                    a[j].value = cellOp(a[j].value, b[j].value);
+            });
+        } else {
+            forEachRow(execution, [&](int i, VectorType& row) {
+                rowOp(row, otherRows ? otherRows[i] : row);
+            });
         }
-        return !minor;
+        return *this;
     }
 
     /**
@@ -309,12 +1478,37 @@ namespace SquareMatrixGM {
  * 
  * This function is a utility that allows iteration over each row using a custom lambda or callable.
  * It is especially useful for applying changes to the matrix without repeating loop logic.
+ * Since every in-place operator goes through here, this is also where shared rows are
+ * detached and the cached sum is invalidated.
+ *
+ * Under the Automatic policy (used by the operators) matrices with at least
+ * PARALLEL_MIN_ROWS rows are processed in parallel on the shared TaskScheduler; the
+ * Parallel policies always split, into tasks of at least MIN_TASK_ELEMENTS elements.
+ * NUMA-placed matrices are split by node instead, one piece per worker of each node.
+ * Callers bring the layout into shape (a transposed copy of the other operand) before
+ * the loop, so func only ever touches row i; the first exception thrown by func is rethrown.
  * 
- * @tparam Func A callable type (e.g., lambda) that accepts two arguments: (int rowIndex, Vector& row)
+ * @tparam Func A callable type (e.g., lambda) that accepts two arguments: (int rowIndex, VectorType& row)
  * @param func The function to apply to each row.
  */
+    template <typename T>
     template <typename Func>
-    void SquareMatrix::forEachRow(Func func) {
+    void BasicSquareMatrix<T>::forEachRow(Func func) {
+        forEachRow(ParallelGM::Execution::Automatic, func);
+    }
+
+    template <typename T>
+    template <typename Func>
+    void BasicSquareMatrix<T>::forEachRow(ParallelGM::Execution execution, Func func) {
+        detach();
+        noteWrite(); // func may write raw cells
+        if (runsParallel(execution, size)) {
+            if (placement.isPlaced())
+                forEachPlacedRow([&](int i) { func(i, rows[i]); });
+            else
+                ParallelGM::parallelFor(0, size, rowGrain(size), [&](int i) { func(i, rows[i]); });
+            return;
+        }
         for (int i = 0; i < size; ++i) {
             func(i, rows[i]);
         }
@@ -325,13 +1519,28 @@ namespace SquareMatrixGM {
  * @brief Applies a given function to each row of the matrix (read-only version).
  * 
  * Similar to the non-const version, but for const contexts. It allows inspection or read-only
- * operations on each row using a lambda function.
+ * operations on each row using a lambda function. Rows may be visited concurrently, so
+ * func must only write to per-row state.
  * 
- * @tparam Func A callable type (e.g., lambda) that accepts two arguments: (int rowIndex, const Vector& row)
+ * @tparam Func A callable type (e.g., lambda) that accepts two arguments: (int rowIndex, const VectorType& row)
  * @param func The function to apply to each row.
  */
+    template <typename T>
     template <typename Func>
-    void SquareMatrix::forEachRow(Func func) const {
+    void BasicSquareMatrix<T>::forEachRow(Func func) const {
+        forEachRow(ParallelGM::Execution::Automatic, func);
+    }
+
+    template <typename T>
+    template <typename Func>
+    void BasicSquareMatrix<T>::forEachRow(ParallelGM::Execution execution, Func func) const {
+        if (runsParallel(execution, size)) {
+            if (placement.isPlaced())
+                forEachPlacedRow([&](int i) { func(i, rows[i]); });
+            else
+                ParallelGM::parallelFor(0, size, rowGrain(size), [&](int i) { func(i, rows[i]); });
+            return;
+        }
         for (int i = 0; i < size; ++i) {
             func(i, rows[i]);
         }
@@ -342,18 +1551,804 @@ namespace SquareMatrixGM {
  * 
  * This method iterates over all rows and sums their values using the Vector::sum() function.
  * It uses the const version of `forEachRow` to avoid code duplication and apply logic cleanly.
+ * Row sums are then added pairwise (Reduction.hpp), so a parallel pass gives the same result.
+ * The result is cached in the shared storage so repeated comparisons cost O(1). It is
+ * keyed on the storage version, which every write to the rows bumps (including writes
+ * through a row reference taken long before), and guarded by a lock, so concurrent
+ * calls on the same or on sharing matrices are safe.
  * 
- * @return double The total sum of all matrix elements.
+ * @return T The total sum of all matrix elements.
  */
-    double SquareMatrix::sum() const {
+    template <typename T>
+    T BasicSquareMatrix<T>::sum() const {
+        Storage& shared = *storage;
+        uint64_t version = shared.version.load(std::memory_order_acquire);
+        {
+            std::lock_guard<std::mutex> guard(shared.cacheLock);
+            if (shared.sumValid && shared.sumVersion == version)
+                return shared.cachedSum;
+        }
         LOG(LogLevel::DEBUG, "Calculating sum of all elements using Vector::sum");
-        double total = 0.0;
-        forEachRow([&](int, const Vector& row) {
-            total += row.sum(); // Assumes Vector::sum() is implemented
-        });
+        PROFILE_OPERATION(MatrixSum, sweepBytes<T>(size, 1), elementCount(size));
+        T* rowSums = MemoryGM::allocateArray<T>(static_cast<std::size_t>(size));
+        MATRIX_TRY {
+            forEachRow([&](int i, const VectorType& row) {
+                rowSums[i] = row.sum();
+            });
+        } MATRIX_CATCH_ALL {
+            MemoryGM::releaseArray(rowSums, static_cast<std::size_t>(size));
+            MATRIX_RETHROW;
+        }
+        T total = VectorGM::pairwiseSum(rowSums, size);
+        MemoryGM::releaseArray(rowSums, static_cast<std::size_t>(size));
+        std::lock_guard<std::mutex> guard(shared.cacheLock);
+        shared.cachedSum = total;
+        shared.sumVersion = version;
+        shared.sumValid = true;
         return total;
     }
 
+   /**
+ * @brief Frobenius norm of the matrix.
+ *
+ * Each row's squared norm is reduced with the pairwise kernels of Reduction.hpp, rows
+ * in parallel for large matrices, and the row results are then added pairwise too.
+ *
+ * @return double sqrt of the sum of squared element magnitudes.
+ * @throws MyLogicError if the matrix is not fully initialized.
+ */
+    template <typename T>
+    double BasicSquareMatrix<T>::frobeniusNorm() const {
+        LOG(LogLevel::DEBUG, "frobeniusNorm() called");
+        PROFILE_OPERATION(MatrixNorm, sweepBytes<T>(size, 1), 2 * elementCount(size));
+        double* rowNorms = MemoryGM::allocateArray<double>(static_cast<std::size_t>(size));
+        MATRIX_TRY {
+            forEachRow([&](int i, const VectorType& row) {
+                if (!row.allInitialized())
+                    MATRIX_THROW(MyLogicError("Matrix must be fully initialized to compute norm"));
+                rowNorms[i] = VectorGM::squaredNormCells(row.cells(), size);
+            });
+        } MATRIX_CATCH_ALL {
+            MemoryGM::releaseArray(rowNorms, static_cast<std::size_t>(size));
+            MATRIX_RETHROW;
+        }
+        double total = VectorGM::pairwiseSum(rowNorms, size);
+        MemoryGM::releaseArray(rowNorms, static_cast<std::size_t>(size));
+        return std::sqrt(total);
+    }
+
+
+   /**
+ * @brief Householder QR factorization with compact WY trailing updates.
+ *
+ * Columns are processed in panels of `blockSize`. Inside a panel each reflector
+ * H = I - tau * v * v^T is generated and applied to the remaining panel columns
+ * only. The panel's reflectors are then aggregated into the compact WY form
+ * H_1 * ... * H_b = I - V * T * V^T (T upper triangular, built as in LAPACK's
+ * larft), and the trailing matrix receives Q_panel^T in three matrix-matrix
+ * products: W = V^T * C, W = T^T * W, C -= V * W. The trailing columns are split
+ * into ranges that run these products independently, in parallel for large matrices.
+ *
+ * @param tau Output vector receiving the reflector scaling factors.
+ * @return BasicSquareMatrix R on and above the diagonal, reflectors below it.
+ * @throws MyLogicError if the matrix is not fully initialized.
+ */
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::householderQR(VectorType& tau) const {
+        LOG(LogLevel::DEBUG, "householderQR() called");
+        PROFILE_OPERATION(MatrixQR, sweepBytes<T>(size, 2), 4 * cubed(size) / 3);
+        const int blockSize = 32;
+        const int columnRange = 64; // trailing columns per task
+        int n = size;
+        MemoryGM::ScratchArray<double> buffer = toBuffer("Matrix must be fully initialized to compute QR factorization");
+        double* a = buffer.get();
+        MemoryGM::ScratchArray<double> taus(static_cast<std::size_t>(n));
+        MemoryGM::ScratchArray<double> v(static_cast<std::size_t>(n) * blockSize);
+        MemoryGM::ScratchArray<double> t(static_cast<std::size_t>(blockSize) * blockSize);
+        MemoryGM::ScratchArray<double> w(static_cast<std::size_t>(blockSize) * n);
+
+        for (int kb = 0; kb < n; kb += blockSize) {
+            int kend = (kb + blockSize < n) ? kb + blockSize : n;
+            int nb = kend - kb;
+
+            // Factor the panel with unblocked Householder reflections.
+            for (int k = kb; k < kend; ++k) {
+                double alpha = a[k * n + k];
+                double sigma = 0.0;
+                for (int i = k + 1; i < n; ++i)
+                    sigma += a[i * n + k] * a[i * n + k];
+                if (sigma == 0.0) {
+                    taus[k] = 0.0;
+                    continue;
+                }
+                double norm = std::sqrt(alpha * alpha + sigma);
+                double beta = alpha <= 0.0 ? norm : -norm;
+                taus[k] = (beta - alpha) / beta;
+                double scale = 1.0 / (alpha - beta);
+                for (int i = k + 1; i < n; ++i)
+                    a[i * n + k] *= scale;
+                a[k * n + k] = beta;
+
+                for (int j = k + 1; j < kend; ++j) {
+                    double dot = a[k * n + j];
+                    for (int i = k + 1; i < n; ++i)
+                        dot += a[i * n + k] * a[i * n + j];
+                    dot *= taus[k];
+                    a[k * n + j] -= dot;
+                    for (int i = k + 1; i < n; ++i)
+                        a[i * n + j] -= dot * a[i * n + k];
+                }
+            }
+            if (kend == n)
+                break;
+
+            // Copy the panel reflectors into V (rows kb..n-1, unit diagonal, zeros above).
+            int m = n - kb;
+            for (int r = 0; r < m; ++r) {
+                for (int c = 0; c < nb; ++c) {
+                    if (r < c) v[r * nb + c] = 0.0;
+                    else if (r == c) v[r * nb + c] = 1.0;
+                    else v[r * nb + c] = a[(kb + r) * n + kb + c];
+                }
+            }
+
+            // T such that H_kb * ... * H_kend-1 = I - V * T * V^T.
+            for (int c = 0; c < nb; ++c) {
+                double tauC = taus[kb + c];
+                for (int i = 0; i < c; ++i) {
+                    double dot = 0.0;
+                    for (int r = c; r < m; ++r)
+                        dot += v[r * nb + i] * v[r * nb + c];
+                    w[i] = -tauC * dot;
+                }
+                for (int i = 0; i < c; ++i) {
+                    double sum = 0.0;
+                    for (int p = i; p < c; ++p)
+                        sum += t[i * blockSize + p] * w[p];
+                    t[i * blockSize + c] = sum;
+                }
+                t[c * blockSize + c] = tauC;
+                for (int i = c + 1; i < nb; ++i)
+                    t[i * blockSize + c] = 0.0;
+            }
+
+            // Trailing update C = (I - V * T^T * V^T) * C on columns kend..n-1. Each range
+            // of columns goes through all three products on its own, so ranges run in parallel.
+            int cols = n - kend;
+            auto updateRange = [&](int range) {
+                int c0 = range * columnRange;
+                int c1 = (c0 + columnRange < cols) ? c0 + columnRange : cols;
+                for (int i = 0; i < nb; ++i) {
+                    double* rowW = w.get() + i * cols;
+                    for (int c = c0; c < c1; ++c)
+                        rowW[c] = 0.0;
+                }
+                for (int r = 0; r < m; ++r) {
+                    const double* rowC = a + (kb + r) * n + kend;
+                    for (int i = 0; i < nb; ++i) {
+                        double vri = v[r * nb + i];
+                        if (vri == 0.0) continue;
+                        double* rowW = w.get() + i * cols;
+                        for (int c = c0; c < c1; ++c)
+                            rowW[c] += vri * rowC[c];
+                    }
+                }
+                for (int i = nb - 1; i >= 0; --i) {
+                    double* rowW = w.get() + i * cols;
+                    for (int c = c0; c < c1; ++c) {
+                        double sum = 0.0;
+                        for (int p = 0; p <= i; ++p)
+                            sum += t[p * blockSize + i] * w[p * cols + c];
+                        rowW[c] = sum;
+                    }
+                }
+                for (int r = 0; r < m; ++r) {
+                    double* rowC = a + (kb + r) * n + kend;
+                    for (int i = 0; i < nb; ++i) {
+                        double vri = v[r * nb + i];
+                        if (vri == 0.0) continue;
+                        const double* rowW = w.get() + i * cols;
+                        for (int c = c0; c < c1; ++c)
+                            rowC[c] -= vri * rowW[c];
+                    }
+                }
+            };
+            int ranges = (cols + columnRange - 1) / columnRange;
+            if (n >= PARALLEL_MIN_ROWS) {
+                ParallelGM::parallelFor(0, ranges, 1, updateRange);
+            } else {
+                for (int range = 0; range < ranges; ++range)
+                    updateRange(range);
+            }
+        }
+
+        tau = fromDoubles(taus.get(), n);
+        return fromBuffer(a, n);
+    }
+
+   /**
+ * @brief Applies Q (or Q^T) from a compact QR factor to a vector without forming Q.
+ *
+ * Q = H_0 * H_1 * ... * H_n-1, so Q * x applies the reflectors last to first and
+ * Q^T * x applies them first to last. Each reflector costs O(n).
+ *
+ * @param factor Compact factor returned by householderQR().
+ * @param tau Reflector scaling factors returned by householderQR().
+ * @param x Input vector.
+ * @param transpose Apply Q^T instead of Q.
+ * @return Vector The product.
+ * @throws MyLogicError if sizes do not match or x is not fully initialized.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::qrApplyQ(const BasicSquareMatrix& factor, const VectorType& tau,
+                                  const VectorType& x, bool transpose) {
+        LOG(LogLevel::DEBUG, "qrApplyQ() called");
+        int n = factor.size;
+        if (x.getSize() != n || tau.getSize() != n)
+            MATRIX_THROW(MyLogicError("Vector size must match matrix size"));
+        if (!x.allInitialized())
+            MATRIX_THROW(MyLogicError("Vector must be fully initialized"));
+
+        MemoryGM::ScratchArray<double> buffer = factor.toBuffer("QR factor must be fully initialized");
+        const double* f = buffer.get();
+        MemoryGM::ScratchArray<double> values = toDoubles(x);
+        double* result = values.get();
+        for (int step = 0; step < n; ++step) {
+            int k = transpose ? step : n - 1 - step;
+            double tauK = VectorGM::ElementTraits<T>::toDouble(tau[k]);
+            if (tauK == 0.0) continue;
+            double dot = result[k];
+            for (int i = k + 1; i < n; ++i)
+                dot += f[i * n + k] * result[i];
+            dot *= tauK;
+            result[k] -= dot;
+            for (int i = k + 1; i < n; ++i)
+                result[i] -= dot * f[i * n + k];
+        }
+        return fromDoubles(result, n);
+    }
+
+   /**
+ * @brief Solves A * x = rhs from a compact QR factor: x = R^-1 * Q^T * rhs.
+ *
+ * @throws MyLogicError if sizes do not match or R has a zero on its diagonal.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::qrSolve(const BasicSquareMatrix& factor, const VectorType& tau, const VectorType& rhs) {
+        LOG(LogLevel::DEBUG, "qrSolve() called");
+        int n = factor.size;
+        VectorType qtb = qrApplyQ(factor, tau, rhs, true);
+        MemoryGM::ScratchArray<double> buffer = factor.toBuffer("QR factor must be fully initialized");
+        const double* r = buffer.get();
+        MemoryGM::ScratchArray<double> values = toDoubles(qtb);
+        double* y = values.get();
+        for (int i = n - 1; i >= 0; --i) {
+            double diag = r[i * n + i];
+            if (std::abs(diag) < 1e-12)
+                MATRIX_THROW(MyLogicError("Matrix is singular and cannot be solved"));
+            double v = y[i];
+            for (int p = i + 1; p < n; ++p)
+                v -= r[i * n + p] * y[p];
+            y[i] = v / diag;
+        }
+        return fromDoubles(y, n);
+    }
+
+   /**
+ * @brief Computes an explicit QR factorization A = Q * R.
+ *
+ * Q is accumulated by applying the reflectors of householderQR() to the identity,
+ * last to first, touching only the columns each reflector can change.
+ *
+ * @param q Output orthogonal matrix.
+ * @param r Output upper-triangular matrix.
+ * @throws MyLogicError if the matrix is not fully initialized.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::qr(BasicSquareMatrix& q, BasicSquareMatrix& r) const {
+        LOG(LogLevel::DEBUG, "qr() called");
+        int n = size;
+        VectorType tau;
+        BasicSquareMatrix factor = householderQR(tau);
+        MemoryGM::ScratchArray<double> buffer = factor.toBuffer("QR factor must be fully initialized");
+        double* f = buffer.get();
+        MemoryGM::ScratchArray<double> product(static_cast<std::size_t>(n) * n);
+        double* qa = product.get();
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                qa[i * n + j] = (i == j ? 1.0 : 0.0);
+
+        for (int k = n - 1; k >= 0; --k) {
+            double tauK = VectorGM::ElementTraits<T>::toDouble(tau[k]);
+            if (tauK == 0.0) continue;
+            for (int j = k; j < n; ++j) {
+                double dot = qa[k * n + j];
+                for (int i = k + 1; i < n; ++i)
+                    dot += f[i * n + k] * qa[i * n + j];
+                dot *= tauK;
+                qa[k * n + j] -= dot;
+                for (int i = k + 1; i < n; ++i)
+                    qa[i * n + j] -= dot * f[i * n + k];
+            }
+        }
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < i; ++j)
+                f[i * n + j] = 0.0;
+
+        q = fromBuffer(qa, n);
+        r = fromBuffer(f, n);
+    }
+
+   /**
+ * @brief Reduces a symmetric row-major n x n array to tridiagonal form T = Q^T * A * Q.
+ *
+ * Blocked like LAPACK's dsytrd (lower). For each panel of `blockSize` columns,
+ * latrd-style steps bring column i up to date with the panel's earlier reflectors,
+ * generate H_i = I - tau_i * v_i * v_i^T from it, and build w_i so that the panel's
+ * two-sided transformation of the trailing matrix is the rank-2k update
+ * A22 -= V * W^T + W * V^T, applied once per panel instead of once per column.
+ * The matrix-vector product of each step and the rank-2k update run by rows, in
+ * parallel for large matrices. Both triangles are kept, so every row is contiguous.
+ *
+ * On return d and e hold the diagonal and subdiagonal of T (e[n-1] = 0), and
+ * column i of `a` below row i + 1 holds v_i, whose entry i + 1 is an implicit 1.
+ */
+    template <typename T>
+    void BasicSquareMatrix<T>::tridiagonalize(double* a, int n, double* d, double* e, double* taus) {
+        const int blockSize = 32;
+        MemoryGM::ScratchArray<double> v(static_cast<std::size_t>(n) * blockSize); // v[p * n + r]: reflector p of the panel
+        MemoryGM::ScratchArray<double> w(static_cast<std::size_t>(n) * blockSize); // w[p * n + r]: its update vector
+        double sV[blockSize];
+        double sW[blockSize];
+        auto forRows = [n](int begin, const auto& body) {
+            if (n - begin >= PARALLEL_MIN_ROWS) {
+                ParallelGM::parallelFor(begin, n, rowGrain(n - begin), body);
+            } else {
+                for (int r = begin; r < n; ++r)
+                    body(r);
+            }
+        };
+
+        for (int kb = 0; kb < n - 1; kb += blockSize) {
+            int kend = (kb + blockSize < n - 1) ? kb + blockSize : n - 1;
+            int nb = kend - kb;
+            for (int j = 0; j < nb; ++j) {
+                int i = kb + j;
+                double* vj = v.get() + static_cast<std::size_t>(j) * n;
+                double* wj = w.get() + static_cast<std::size_t>(j) * n;
+
+                // Column i with the panel's earlier reflectors applied.
+                for (int r = i; r < n; ++r) {
+                    double update = 0.0;
+                    for (int p = 0; p < j; ++p)
+                        update += v[p * n + r] * w[p * n + i] + w[p * n + r] * v[p * n + i];
+                    a[r * n + i] -= update;
+                }
+                d[i] = a[i * n + i];
+
+                // Reflector that zeroes rows i+2.. of column i.
+                for (int r = 0; r <= i; ++r) {
+                    vj[r] = 0.0;
+                    wj[r] = 0.0;
+                }
+                double alpha = a[(i + 1) * n + i];
+                double sigma = 0.0;
+                for (int r = i + 2; r < n; ++r)
+                    sigma += a[r * n + i] * a[r * n + i];
+                vj[i + 1] = 1.0;
+                if (sigma == 0.0) {
+                    taus[i] = 0.0;
+                    e[i] = alpha;
+                    for (int r = i + 1; r < n; ++r) {
+                        vj[r] = r == i + 1 ? 1.0 : 0.0;
+                        wj[r] = 0.0;
+                    }
+                    continue;
+                }
+                double norm = std::sqrt(alpha * alpha + sigma);
+                double beta = alpha <= 0.0 ? norm : -norm;
+                double tau = (beta - alpha) / beta;
+                double scale = 1.0 / (alpha - beta);
+                for (int r = i + 2; r < n; ++r) {
+                    a[r * n + i] *= scale;
+                    vj[r] = a[r * n + i];
+                }
+                taus[i] = tau;
+                e[i] = beta;
+
+                // w = tau * (A22 - V * W^T - W * V^T) * v, then w -= (tau / 2) * (w . v) * v.
+                forRows(i + 1, [&](int r) {
+                    const double* row = a + r * n;
+                    double dot = 0.0;
+                    for (int c = i + 1; c < n; ++c)
+                        dot += row[c] * vj[c];
+                    wj[r] = dot;
+                });
+                for (int p = 0; p < j; ++p) {
+                    const double* vp = v.get() + static_cast<std::size_t>(p) * n;
+                    const double* wp = w.get() + static_cast<std::size_t>(p) * n;
+                    double dotV = 0.0, dotW = 0.0;
+                    for (int r = i + 1; r < n; ++r) {
+                        dotV += vp[r] * vj[r];
+                        dotW += wp[r] * vj[r];
+                    }
+                    sV[p] = dotV;
+                    sW[p] = dotW;
+                }
+                for (int p = 0; p < j; ++p) {
+                    const double* vp = v.get() + static_cast<std::size_t>(p) * n;
+                    const double* wp = w.get() + static_cast<std::size_t>(p) * n;
+                    for (int r = i + 1; r < n; ++r)
+                        wj[r] -= vp[r] * sW[p] + wp[r] * sV[p];
+                }
+                double dot = 0.0;
+                for (int r = i + 1; r < n; ++r) {
+                    wj[r] *= tau;
+                    dot += wj[r] * vj[r];
+                }
+                double half = -0.5 * tau * dot;
+                for (int r = i + 1; r < n; ++r)
+                    wj[r] += half * vj[r];
+            }
+
+            // Rank-2k update of the trailing matrix, both triangles.
+            forRows(kend, [&](int r) {
+                double* row = a + r * n;
+                for (int p = 0; p < nb; ++p) {
+                    double vr = v[p * n + r];
+                    double wr = w[p * n + r];
+                    const double* vp = v.get() + static_cast<std::size_t>(p) * n;
+                    const double* wp = w.get() + static_cast<std::size_t>(p) * n;
+                    for (int c = kend; c < n; ++c)
+                        row[c] -= vr * wp[c] + wr * vp[c];
+                }
+            });
+        }
+        if (n > 0) {
+            d[n - 1] = a[(n - 1) * n + n - 1];
+            e[n - 1] = 0.0;
+        }
+    }
+
+   /**
+ * @brief Eigen-decomposes a symmetric matrix into raw buffers.
+ *
+ * Stage 1 reduces the matrix to tridiagonal form T = Q^T * A * Q with blocked
+ * Householder reflections (tridiagonalize). Stage 2 diagonalizes T with the
+ * implicit QL algorithm and the standard tqli shift. When `wantVectors` is false
+ * Q is never formed and stage 2 rotates no vectors, which removes most of the
+ * O(n^3) work. Otherwise Q is accumulated from the reflectors, last to first, and
+ * kept transposed (one eigenvector per row) so that the Givens rotations of stage 2
+ * update two contiguous rows. Each QL sweep's rotations are applied together, by
+ * column ranges, in parallel for large matrices.
+ *
+ * @param values Output array of `size` eigenvalues, sorted ascending.
+ * @param wantVectors Whether to accumulate the eigenvectors.
+ * @return ScratchArray Row-major array whose row j is eigenvector j, empty if not requested.
+ * @throws MyLogicError if the matrix is uninitialized, not symmetric, or QL does not converge.
+ */
+    template <typename T>
+    MemoryGM::ScratchArray<double> BasicSquareMatrix<T>::symmetricEigen(double* values, bool wantVectors) const {
+        PROFILE_OPERATION(MatrixEigen, sweepBytes<T>(size, 2), 9 * cubed(size));
+        const int columnRange = 64; // columns of Q per task
+        int n = size;
+        MemoryGM::ScratchArray<double> buffer = toBuffer("Matrix must be fully initialized to compute eigenvalues");
+        double* z = buffer.get();
+        MemoryGM::ScratchArray<double> accumulated(wantVectors ? static_cast<std::size_t>(n) * n : 0);
+        double* vectors = wantVectors && n > 0 ? accumulated.get() : nullptr;
+        double* d = values;
+        MemoryGM::ScratchArray<double> e(static_cast<std::size_t>(n > 0 ? n : 1));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < i; ++j) {
+                if (std::abs(z[i * n + j] - z[j * n + i]) > 1e-9 * (1.0 + std::abs(z[i * n + j])))
+                    MATRIX_THROW(MyLogicError("Matrix must be symmetric for the eigensolver"));
+            }
+        }
+        MemoryGM::ScratchArray<double> taus(static_cast<std::size_t>(n > 0 ? n : 1));
+        {
+            TRACE_SPAN("tridiagonalize");
+            tridiagonalize(z, n, d, e.get(), taus.get());
+        }
+
+        if (wantVectors) {
+            TRACE_SPAN("accumulate Q");
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
+                    vectors[i * n + j] = (i == j ? 1.0 : 0.0);
+            // Q = H_0 * ... * H_n-2: H_i only touches rows and columns i+1.. of the product so far.
+            MemoryGM::ScratchArray<double> dots(static_cast<std::size_t>(n));
+            for (int i = n - 2; i >= 0; --i) {
+                double tau = taus[i];
+                if (tau == 0.0) continue;
+                int first = i + 1;
+                auto applyRange = [&](int range) {
+                    int c0 = first + range * columnRange;
+                    int c1 = (c0 + columnRange < n) ? c0 + columnRange : n;
+                    double* lead = vectors + first * n;
+                    for (int c = c0; c < c1; ++c)
+                        dots[c] = lead[c];
+                    for (int r = first + 1; r < n; ++r) {
+                        double vr = z[r * n + i];
+                        if (vr == 0.0) continue;
+                        const double* row = vectors + r * n;
+                        for (int c = c0; c < c1; ++c)
+                            dots[c] += vr * row[c];
+                    }
+                    for (int c = c0; c < c1; ++c) {
+                        dots[c] *= tau;
+                        lead[c] -= dots[c];
+                    }
+                    for (int r = first + 1; r < n; ++r) {
+                        double vr = z[r * n + i];
+                        if (vr == 0.0) continue;
+                        double* row = vectors + r * n;
+                        for (int c = c0; c < c1; ++c)
+                            row[c] -= dots[c] * vr;
+                    }
+                };
+                int ranges = (n - first + columnRange - 1) / columnRange;
+                if (n - first >= PARALLEL_MIN_ROWS) {
+                    ParallelGM::parallelFor(0, ranges, 1, applyRange);
+                } else {
+                    for (int range = 0; range < ranges; ++range)
+                        applyRange(range);
+                }
+            }
+            for (int i = 0; i < n; ++i)
+                for (int j = i + 1; j < n; ++j)
+                    std::swap(vectors[i * n + j], vectors[j * n + i]);
+        }
+
+        // Implicit QL on the tridiagonal matrix; e[i] couples d[i] and d[i + 1].
+        const double eps = std::numeric_limits<double>::epsilon();
+        // A sweep's Givens rotations are recorded, then applied to the eigenvector rows by column ranges:
+        // every column takes the whole sweep in order, independently of the others.
+        MemoryGM::ScratchArray<double> rotationC(static_cast<std::size_t>(n > 0 ? n : 1));
+        MemoryGM::ScratchArray<double> rotationS(static_cast<std::size_t>(n > 0 ? n : 1));
+        auto rotate = [&](int low, int high) {
+            auto rotateRange = [&](int range) {
+                int c0 = range * columnRange;
+                int c1 = (c0 + columnRange < n) ? c0 + columnRange : n;
+                for (int i = high - 1; i >= low; --i) {
+                    double* vi = vectors + i * n;
+                    double* vi1 = vectors + (i + 1) * n;
+                    double c = rotationC[i], s = rotationS[i];
+                    for (int k = c0; k < c1; ++k) {
+                        double f = vi1[k];
+                        vi1[k] = s * vi[k] + c * f;
+                        vi[k] = c * vi[k] - s * f;
+                    }
+                }
+            };
+            int ranges = (n + columnRange - 1) / columnRange;
+            if (ranges > 1 && static_cast<long>(high - low) * n >= MIN_TASK_ELEMENTS) {
+                ParallelGM::parallelFor(0, ranges, 1, rotateRange);
+            } else {
+                for (int range = 0; range < ranges; ++range)
+                    rotateRange(range);
+            }
+        };
+        for (int l = 0; l < n; ++l) {
+            int iter = 0;
+            int m;
+            do {
+                for (m = l; m < n - 1; ++m) {
+                    double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                    if (std::abs(e[m]) <= eps * dd)
+                        break;
+                }
+                if (m != l) {
+                    if (iter++ == 60)
+                        MATRIX_THROW(MyLogicError("Eigenvalue iteration did not converge"));
+                    double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+                    double r = std::hypot(g, 1.0);
+                    g = d[m] - d[l] + e[l] / (g + (g >= 0.0 ? std::abs(r) : -std::abs(r)));
+                    double s = 1.0, c = 1.0, p = 0.0;
+                    int i;
+                    for (i = m - 1; i >= l; --i) {
+                        double f = s * e[i];
+                        double b = c * e[i];
+                        e[i + 1] = (r = std::hypot(f, g));
+                        if (r == 0.0) {
+                            d[i + 1] -= p;
+                            e[m] = 0.0;
+                            break;
+                        }
+                        s = f / r;
+                        c = g / r;
+                        g = d[i + 1] - p;
+                        r = (d[i] - g) * s + 2.0 * c * b;
+                        d[i + 1] = g + (p = s * r);
+                        g = c * r - b;
+                        rotationC[i] = c;
+                        rotationS[i] = s;
+                    }
+                    if (vectors)
+                        rotate(i + 1, m);
+                    if (r == 0.0 && i >= l)
+                        continue;
+                    d[l] -= p;
+                    e[l] = g;
+                    e[m] = 0.0;
+                }
+            } while (m != l);
+        }
+
+        // Sort ascending (selection sort keeps the row swaps to at most n).
+        for (int i = 0; i < n - 1; ++i) {
+            int best = i;
+            for (int j = i + 1; j < n; ++j)
+                if (d[j] < d[best])
+                    best = j;
+            if (best == i) continue;
+            double tmp = d[i];
+            d[i] = d[best];
+            d[best] = tmp;
+            if (vectors) {
+                for (int k = 0; k < n; ++k) {
+                    tmp = vectors[i * n + k];
+                    vectors[i * n + k] = vectors[best * n + k];
+                    vectors[best * n + k] = tmp;
+                }
+            }
+        }
+        return accumulated;
+    }
+
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::eigenvalues() const {
+        LOG(LogLevel::DEBUG, "eigenvalues() called");
+        MemoryGM::ScratchArray<double> values(static_cast<std::size_t>(size));
+        symmetricEigen(values.get(), false);
+        return fromDoubles(values.get(), size);
+    }
+
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::eigen(BasicSquareMatrix& eigenvectors) const {
+        LOG(LogLevel::DEBUG, "eigen() called");
+        int n = size;
+        MemoryGM::ScratchArray<double> values(static_cast<std::size_t>(n));
+        MemoryGM::ScratchArray<double> accumulated = symmetricEigen(values.get(), true);
+        double* vectors = accumulated.get();
+        VectorType result = fromDoubles(values.get(), n);
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j) {
+                double tmp = vectors[i * n + j];
+                vectors[i * n + j] = vectors[j * n + i];
+                vectors[j * n + i] = tmp;
+            }
+        eigenvectors = fromBuffer(vectors, n);
+        return result;
+    }
+
+   /**
+ * @brief Computes A^k for a real exponent through the eigendecomposition A = V * D * V^T.
+ *
+ * A^k = V * D^k * V^T, so the cost is one eigendecomposition plus one O(n^3)
+ * reconstruction regardless of how large k is.
+ *
+ * @param exponent The real power k.
+ * @return BasicSquareMatrix The matrix A^k.
+ * @throws MyLogicError for a fractional power with a negative eigenvalue, a negative
+ *         power with a zero eigenvalue, or any error raised by the eigensolver.
+ */
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::power(double exponent) const {
+        LOG(LogLevel::DEBUG, "power() called with exponent = " << exponent);
+        PROFILE_OPERATION(MatrixRealPower, 0, 0); // charged the eigen-decomposition it runs
+        int n = size;
+        MemoryGM::ScratchArray<double> values(static_cast<std::size_t>(n));
+        MemoryGM::ScratchArray<double> accumulated = symmetricEigen(values.get(), true);
+        const double* vectors = accumulated.get();
+
+        // An eigenvalue counts as zero relative to the spectral radius (= ||A||_2 for a symmetric A).
+        double radius = 0.0;
+        for (int p = 0; p < n; ++p)
+            if (std::abs(values[p]) > radius)
+                radius = std::abs(values[p]);
+        const double tolerance = n * std::numeric_limits<double>::epsilon() * radius;
+        bool integral = std::floor(exponent) == exponent;
+        for (int p = 0; p < n; ++p) {
+            const char* error = nullptr;
+            if (!integral && values[p] < 0.0)
+                error = "Fractional power of a matrix with negative eigenvalues";
+            else if (exponent < 0.0 && !(std::abs(values[p]) > tolerance))
+                error = "Matrix is singular and cannot be raised to a negative power";
+            if (error)
+                MATRIX_THROW(MyLogicError(error));
+            values[p] = std::pow(values[p], exponent);
+        }
+
+        MemoryGM::ScratchArray<double> reconstructed(static_cast<std::size_t>(n) * n);
+        double* a = reconstructed.get();
+        for (int i = 0; i < n * n; ++i)
+            a[i] = 0.0;
+        for (int p = 0; p < n; ++p) {
+            const double* v = vectors + p * n;
+            for (int i = 0; i < n; ++i) {
+                double scaled = v[i] * values[p];
+                if (scaled == 0.0) continue;
+                double* row = a + i * n;
+                for (int j = 0; j < n; ++j)
+                    row[j] += scaled * v[j];
+            }
+        }
+        return fromBuffer(a, n);
+    }
+
+   /**
+ * @brief Copies the matrix into a newly allocated row-major array.
+ *
+ * Used by the factorizations, which run on a contiguous buffer instead of
+ * going through the checked row accessors. The returned array is recorded by the
+ * memory accounting and released when it goes out of scope.
+ *
+ * Every factorization enters through here, so this is also where non floating-point
+ * element types are rejected.
+ *
+ * @param operation Error message used if a cell is not initialized.
+ * @return ScratchArray Array of size*size elements.
+ * @throws MyLogicError if the matrix is not fully initialized or T is not floating point.
+ */
+    template <typename T>
+    MemoryGM::ScratchArray<double> BasicSquareMatrix<T>::toBuffer(const char* operation) const {
+        if (!VectorGM::ElementTraits<T>::isFloatingPoint)
+            MATRIX_THROW(MyLogicError("Factorizations require a floating-point element type"));
+        forEachRow([&](int, const VectorType& row) {
+            if (!row.allInitialized())
+                MATRIX_THROW(MyLogicError(operation));
+        });
+        MemoryGM::ScratchArray<double> buffer(static_cast<std::size_t>(size) * size);
+        forEachRow([&](int i, const VectorType& row) {
+            for (int j = 0; j < size; ++j) {
+                std::size_t index = transposed ? static_cast<std::size_t>(j) * size + i : static_cast<std::size_t>(i) * size + j;
+                buffer[index] = VectorGM::ElementTraits<T>::toDouble(row[j]);
+            }
+        });
+        return buffer;
+    }
+
+   /**
+ * @brief Builds a matrix from a row-major array of size*size elements.
+ */
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::fromBuffer(const double* buffer, int size) {
+        BasicSquareMatrix result(size);
+        for (int i = 0; i < size; ++i) {
+            VectorGM::BasicCell<T>* out = result.rows[i].cells();
+            for (int j = 0; j < size; ++j) {
+                out[j].value = VectorGM::ElementTraits<T>::fromDouble(buffer[i * size + j]);
+                out[j].initialized = true;
+            }
+        }
+        return result;
+    }
+
+   /**
+ * @brief Copies a fully initialized vector into a new, accounted double array.
+ * @throws MyLogicError if the vector is not fully initialized.
+ */
+    template <typename T>
+    MemoryGM::ScratchArray<double> BasicSquareMatrix<T>::toDoubles(const VectorType& vector) {
+        if (!vector.allInitialized())
+            MATRIX_THROW(MyLogicError("Vector must be fully initialized"));
+        int n = vector.getSize();
+        MemoryGM::ScratchArray<double> values(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i)
+            values[i] = VectorGM::ElementTraits<T>::toDouble(vector[i]);
+        return values;
+    }
+
+   /**
+ * @brief Builds a vector from a double array of `count` elements.
+ */
+    template <typename T>
+    typename BasicSquareMatrix<T>::VectorType BasicSquareMatrix<T>::fromDoubles(const double* values, int count) {
+        VectorType result(count);
+        for (int i = 0; i < count; ++i)
+            result[i] = VectorGM::ElementTraits<T>::fromDouble(values[i]);
+        return result;
+    }
 
    /**
  * @brief Creates an identity matrix of given size.
@@ -362,16 +2357,27 @@ namespace SquareMatrixGM {
  * This static method constructs such a matrix and returns it.
  * 
  * @param size The dimension of the identity matrix.
- * @return SquareMatrix The identity matrix of the given size.
+ * @return BasicSquareMatrix The identity matrix of the given size.
  */
-    SquareMatrix SquareMatrix::identity(int size) {
+    template <typename T>
+    BasicSquareMatrix<T> BasicSquareMatrix<T>::identity(int size) {
         LOG(LogLevel::DEBUG, "Creating identity matrix of size = " << size);
-        SquareMatrix result(size);
-        for (int i = 0; i < size; ++i)
-            for (int j = 0; j < size; ++j)
-                result[i][j] = (i == j ? 1.0 : 0.0);
+        BasicSquareMatrix result(size);
+        for (int i = 0; i < size; ++i) {
+            VectorGM::BasicCell<T>* row = result.rows[i].cells();
+            for (int j = 0; j < size; ++j) {
+                row[j].value = i == j ? T(1) : T();
+                row[j].initialized = true;
+            }
+        }
         return result;
     }
 
+    // Explicit instantiations, one per supported element type.
+    template class BasicSquareMatrix<float>;
+    template class BasicSquareMatrix<double>;
+    template class BasicSquareMatrix<int32_t>;
+    template class BasicSquareMatrix<int64_t>;
+    template class BasicSquareMatrix<std::complex<double>>;
 
-}
\ No newline at end of file
+}
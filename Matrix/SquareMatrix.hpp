@@ -1,11 +1,17 @@
 /**
  * Author: Gal Maymon
  * Email: your.email@example.com
- * @brief Definition of the SquareMatrix class for square matrix operations.
+ * @brief Definition of the BasicSquareMatrix class template for square matrix operations.
  *
  * This class represents a square matrix using an array of Vector objects.
  * Each row of the matrix is stored as a Vector, allowing use of Vector's operators
  * and functionalities such as addition, scalar multiplication, transposition, and more.
+ * The row array is reference-counted and copied on write, so copies and by-value
+ * returns are O(1) until one of the matrices is modified.
+ * An optional NumaPlacement spreads the rows over NUMA nodes; row loops of a placed
+ * matrix then run each row on a worker of the node that holds it.
+ * Matrices whose cells reach MemoryGM::hugePageThreshold() keep all rows in one
+ * huge-page backed slab.
  * 
  * The class provides rich operator overloading, including arithmetic, comparison,
  * transpose (~), power (^), determinant (!), and increment/decrement.
@@ -15,23 +21,156 @@
  #ifndef SQUARE_MATRIX_HPP
  #define SQUARE_MATRIX_HPP
  
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ #include <mutex>
  #include <ostream>
  #include <cmath>
  #include "../Vector/Vector.hpp"
+ #include "../Memory/MemoryAccounting.hpp"
+ #include "../Exception/MyExceptions.hpp"
+ #include "../Parallel/ExecutionPolicy.hpp"
+ #include "../Parallel/NumaTopology.hpp"
  
  namespace SquareMatrixGM {
+
+	 template <typename T>
+	 class BasicSquareMatrixView;
  
 	 /**
-	  * @class SquareMatrix
+	  * @class BasicSquareMatrix
 	  * @brief A class representing a square matrix using dynamically allocated rows of Vectors.
+	  *
+	  * The element type T is one of the types supported by VectorGM::BasicVector
+	  * (float, double, int32_t, int64_t, std::complex<double>); `SquareMatrix` is the
+	  * original double-precision matrix. The factorizations (inverse, cholesky, QR,
+	  * eigen and real powers) require a floating-point element type and throw
+	  * MyLogicError otherwise.
 	  */
-	 class SquareMatrix {
+	 template <typename T>
+	 class BasicSquareMatrix {
+	 public:
+		 using VectorType = VectorGM::BasicVector<T>; ///< Row type
+		 using value_type = T; ///< Element type
+
+		 /**
+		  * @brief Owning, move-only list of vectors, returned by multiplyVectors(); it frees them itself.
+		  */
+		 class VectorList {
+		 public:
+			 VectorList(VectorList&& other) noexcept : vectors(other.vectors), count(other.count) {
+				 other.vectors = nullptr;
+				 other.count = 0;
+			 }
+			 ~VectorList() { VectorType::releaseRows(vectors, count); }
+			 VectorList(const VectorList&) = delete;
+			 VectorList& operator=(const VectorList&) = delete;
+			 VectorList& operator=(VectorList&&) = delete;
+
+			 int getSize() const { return count; } ///< Number of vectors
+			 VectorType& operator[](int index) { return vectors[checked(index)]; } ///< @throws MyOutOfRange
+			 const VectorType& operator[](int index) const { return vectors[checked(index)]; } ///< @throws MyOutOfRange
+			 VectorType* begin() { return vectors; }
+			 VectorType* end() { return vectors + count; }
+			 const VectorType* begin() const { return vectors; }
+			 const VectorType* end() const { return vectors + count; }
+
+		 private:
+			 friend class BasicSquareMatrix;
+			 explicit VectorList(int count)
+				 : vectors(MemoryGM::allocateArray<VectorType>(static_cast<std::size_t>(count))), count(count) {}
+			 int checked(int index) const {
+				 if (index < 0 || index >= count)
+					 MATRIX_THROW(MyOutOfRange());
+				 return index;
+			 }
+
+			 VectorType* vectors;
+			 int count;
+		 };
+
+		 /**
+		  * @brief A writable row, returned by the mutable operator[]: `m[i][j] = x`.
+		  *
+		  * It names the row by index and looks it up again, after detaching shared rows,
+		  * for every write, so copies of the matrix keep their values whenever they were
+		  * made. Element references (`T& x = m[i][j]`) and cells() are only good until the
+		  * matrix is next copied.
+		  */
+		 class RowReference {
+		 public:
+			 RowReference(const RowReference&) = default;
+
+			 T& operator[](int index) const { return row()[index]; } ///< Writable element; marks it initialized
+			 operator const VectorType&() const { return read(); } ///< The row, read without detaching
+
+			 RowReference& operator=(const RowReference& other) { return *this = other.read(); }
+			 RowReference& operator=(const VectorType& values) { row() = values; return *this; }
+			 RowReference& operator+=(const VectorType& other) { row() += other; return *this; }
+			 RowReference& operator-=(const VectorType& other) { row() -= other; return *this; }
+
+			 /// Raw cells for a bulk fill (value and initialized); counts as a write to the row.
+			 VectorGM::BasicCell<T>* cells() const {
+				 VectorType& target = row();
+				 matrix->noteWrite();
+				 return target.cells();
+			 }
+
+			 int getSize() const { return read().getSize(); }
+			 bool isInitialized(int index) const { return read().isInitialized(index); }
+			 bool allInitialized() const { return read().allInitialized(); }
+			 T sum() const { return read().sum(); }
+
+		 private:
+			 friend class BasicSquareMatrix;
+			 RowReference(BasicSquareMatrix& matrix, int index) : matrix(&matrix), index(index) {}
+			 VectorType& row() const { return matrix->writableRow(index); }
+			 const VectorType& read() const { return static_cast<const BasicSquareMatrix&>(*matrix)[index]; }
+
+			 BasicSquareMatrix* matrix;
+			 int index;
+		 };
+
 	 private:
-		 VectorGM::Vector* rows; ///< Array of Vector rows
+		 friend class BasicSquareMatrixView<T>;
+
+		 /**
+		  * @brief Row storage shared between copies (copy-on-write).
+		  *
+		  * Every row reports its writes to `version` (BasicVector::observeWrites), and so do
+		  * the raw-cell kernels; the cached sum is valid only for the version it was taken at.
+		  */
+		 struct Storage {
+			 VectorType* rows;          ///< Array of Vector rows
+			 VectorGM::BasicCell<T>* slab; ///< Cells of every row in one huge-page buffer, or nullptr
+			 std::atomic<int> refCount; ///< Number of matrices sharing these rows
+			 std::atomic<uint64_t> version; ///< Bumped by every write to the rows
+			 std::mutex cacheLock; ///< Guards the fields below; const members may run on several threads
+			 T cachedSum; ///< Last value computed by sum()
+			 uint64_t sumVersion; ///< version the cached sum was computed at
+			 bool sumValid; ///< Whether cachedSum has been computed at all
+			 std::atomic<VectorType*> columns; ///< Physical columns as rows, for const row access of a transposed matrix, or nullptr; set under cacheLock
+			 std::atomic<uint64_t> columnsVersion; ///< version the columns were copied at; set under cacheLock
+		 };
+
+		 mutable Storage* storage; ///< Shared rows; detached before the first mutation
+		 mutable VectorType* rows; ///< Always storage->rows, kept for direct access
 		 int size; ///< Size of the square matrix (NxN)
+		 mutable bool transposed; ///< Physical rows hold the logical columns (set by operator~)
+		 ParallelGM::NumaPlacement placement; ///< NUMA node of every row; inherited by results
+
+		 struct RowShells {}; ///< Constructor tag: rows without cells, filled by move assignment
+
+		 /**
+		  * @brief A result matrix whose rows get their cells from the Vector temporaries
+		  * assigned to them, so each row costs one allocation. Slab-backed rows keep their
+		  * cells and copy instead.
+		  */
+		 BasicSquareMatrix(int size, ParallelGM::NumaPlacement placement, RowShells);
  
 		 /**
-		  * @brief Applies a function to each row (non-const).
+		  * @brief Applies a function to each row (non-const). Invalidates the cached sum.
 		  * @tparam Func A callable object taking (int index, Vector&)
 		  */
 		 template <typename Func>
@@ -43,10 +182,68 @@
 		  */
 		 template <typename Func>
 		 void forEachRow(Func func) const;
+
+		 template <typename Func>
+		 void forEachRow(ParallelGM::Execution execution, Func func); ///< forEachRow under an explicit policy.
+
+		 template <typename Func>
+		 void forEachRow(ParallelGM::Execution execution, Func func) const; ///< forEachRow under an explicit policy.
+
+		 /**
+		  * @brief Builds a new matrix from rowOp (Vector kernels) or cellOp (raw-cell kernel for par_unseq).
+		  */
+		 template <typename RowOp, typename CellOp>
+		 BasicSquareMatrix mapRows(ParallelGM::Execution execution, const BasicSquareMatrix* other,
+								   RowOp rowOp, CellOp cellOp, const char* uninitialized) const;
+
+		 /**
+		  * @brief Updates this matrix with rowOp (Vector kernels) or cellOp (raw-cell kernel for par_unseq).
+		  */
+		 template <typename RowOp, typename CellOp>
+		 BasicSquareMatrix& updateRows(ParallelGM::Execution execution, const BasicSquareMatrix* other,
+									   RowOp rowOp, CellOp cellOp, const char* uninitialized);
+
+		 /**
+		  * @brief Writes this * vectors[r] into results[r] (already sized) for every r; row tiles in parallel.
+		  */
+		 void multiplyInto(const VectorType* vectors, int count, VectorType* results) const;
+
+		 // Policy-aware bodies of the element-wise operators; the operators use Execution::Automatic.
+		 BasicSquareMatrix plus(ParallelGM::Execution execution, const BasicSquareMatrix& other) const;
+		 BasicSquareMatrix minus(ParallelGM::Execution execution, const BasicSquareMatrix& other) const;
+		 BasicSquareMatrix hadamard(ParallelGM::Execution execution, const BasicSquareMatrix& other) const;
+		 BasicSquareMatrix negated(ParallelGM::Execution execution) const;
+		 BasicSquareMatrix& addAssign(ParallelGM::Execution execution, const BasicSquareMatrix& other);
+		 BasicSquareMatrix& subtractAssign(ParallelGM::Execution execution, const BasicSquareMatrix& other);
+		 BasicSquareMatrix& scaleAssign(ParallelGM::Execution execution, T scalar);
+		 BasicSquareMatrix& divideAssign(ParallelGM::Execution execution, T scalar);
+		 BasicSquareMatrix& moduloAssign(ParallelGM::Execution execution, int scalar);
+		 BasicSquareMatrix& incrementAssign(ParallelGM::Execution execution);
+		 BasicSquareMatrix& decrementAssign(ParallelGM::Execution execution);
  
-		 static SquareMatrix identity(int size); ///< Creates identity matrix of given size.
-		 double sum() const; ///< Computes the sum of all elements in the matrix.
-		 double getMinor(int rowToRemove, int colToRemove) const; ///< Computes determinant minor.
+		 void detach() const; ///< Gives this matrix its own copy of shared rows before a write.
+		 Storage* share() const; ///< These rows with one more reference, for a new copy of this matrix.
+		 VectorType& writableRow(int row); ///< Row `row` for a write: layout materialized, shared rows detached.
+		 void relocate() const; ///< Copies the rows into a fresh, exclusively owned and placed array.
+		 Storage* allocateStorage(const VectorType* source, bool shells = false) const; ///< New rows: empty, copied from source, or shells.
+		 template <typename Func>
+		 void forEachPlacedRow(Func func) const; ///< Calls func(i) for every row, on the row's node when placed.
+		 static void checkPlacement(ParallelGM::NumaPlacement placement); ///< @throws InvalidArgument for a bind to an unknown node
+		 void release(); ///< Drops this matrix's reference to its rows.
+		 void noteWrite() const; ///< Records a write to the rows that bypassed the Vector API (raw cells).
+		 std::size_t slabBytes() const; ///< Bytes of all cells
+		 std::size_t rowArrayBytes() const; ///< Bytes of the Storage and its row array
+		 void materialize(); ///< Rewrites a transposed layout in place so rows are logical rows.
+		 void transposeInto(VectorType* out) const; ///< Copies the physical columns into the `size` rows of out.
+		 static BasicSquareMatrix identity(int size); ///< Creates identity matrix of given size.
+		 T sum() const; ///< Sum of all elements, cached until the rows are next written.
+		 static T determinant(T* work, int n); ///< Determinant of a row-major n x n array (overwrites it).
+		 MemoryGM::ScratchArray<double> toBuffer(const char* operation) const; ///< Copies a fully initialized matrix into a new row-major array.
+		 MemoryGM::ScratchArray<double> symmetricEigen(double* values, bool wantVectors) const; ///< Eigen-decomposes a symmetric matrix into raw buffers.
+		 static void tridiagonalize(double* a, int n, double* d, double* e, double* taus); ///< Blocked Householder reduction of a symmetric array.
+		 static BasicSquareMatrix fromBuffer(const double* buffer, int size); ///< Builds a matrix from a row-major array.
+		 static MemoryGM::ScratchArray<double> toDoubles(const VectorType& vector); ///< Copies a fully initialized vector into a new double array.
+		 static VectorType fromDoubles(const double* values, int count); ///< Builds a vector from a double array.
  
 	 public:
 		 // === Constructors and Destructor ===
@@ -54,103 +251,316 @@
 		 /**
 		  * @brief Constructs a square matrix of given size (NxN).
 		  * @param size Size of the matrix.
+		  * @param placement NUMA placement of the rows; each row is allocated and first
+		  * touched by a worker of its node.
+		  * @throws InvalidArgument if size is negative or `placement` binds to a node that is not online.
 		  */
-		 SquareMatrix(int size);
+		 BasicSquareMatrix(int size, ParallelGM::NumaPlacement placement = ParallelGM::NumaPlacement::byDefault());
  
 		 /**
-		  * @brief Copy constructor.
+		  * @brief Copy constructor. Shares the rows until either matrix is modified.
 		  */
-		 SquareMatrix(const SquareMatrix& other);
+		 BasicSquareMatrix(const BasicSquareMatrix& other);
  
 		 /**
-		  * @brief Copy assignment operator.
+		  * @brief Copy assignment operator. Shares the rows like the copy constructor.
+		  */
+		 BasicSquareMatrix& operator=(const BasicSquareMatrix& other);
+
+		 /**
+		  * @brief Move constructor. Takes over the rows; `other` can then only be assigned or destroyed.
+		  */
+		 BasicSquareMatrix(BasicSquareMatrix&& other) noexcept;
+
+		 /**
+		  * @brief Move assignment. Swaps the rows with `other`, whose destructor frees the old ones.
 		  */
-		 SquareMatrix& operator=(const SquareMatrix& other);
+		 BasicSquareMatrix& operator=(BasicSquareMatrix&& other) noexcept;
  
 		 /**
 		  * @brief Destructor.
 		  */
-		 ~SquareMatrix();
+		 ~BasicSquareMatrix();
  
 		 // === Element Access ===
  
 		 /**
-		  * @brief Access row by index (modifiable).
+		  * @brief Access row by index (modifiable). Writes through the returned RowReference,
+		  * even much later, detach shared rows first and invalidate the cached sum.
 		  */
-		 VectorGM::Vector& operator[](int row);
+		 RowReference operator[](int row);
  
 		 /**
 		  * @brief Access row by index (read-only).
+		  *
+		  * Never rewrites the layout, so it is safe to call from several threads. After
+		  * operator~ the logical rows are physical columns; they are then served from a
+		  * transposed copy kept with the rows and rebuilt (outside any lock) after the rows
+		  * are written.
 		  */
-		 const VectorGM::Vector& operator[](int row) const;
+		 const VectorType& operator[](int row) const;
  
 		 /**
 		  * @brief Returns the size (dimension) of the matrix.
 		  */
 		 int getSize() const;
+
+		 /**
+		  * @brief Bytes this matrix holds, cells included (see MemoryAccounting.hpp).
+		  */
+		 std::size_t footprint() const;
+
+		 /**
+		  * @brief Changes the NUMA placement, moving every row to its new node. Values are kept.
+		  * @throws InvalidArgument if `placement` binds to a node that is not online.
+		  */
+		 void setPlacement(ParallelGM::NumaPlacement placement);
+
+		 ParallelGM::NumaPlacement getPlacement() const; ///< Current NUMA placement of the rows
+
+		 // === Views ===
+
+		 /**
+		  * @brief Writable view of the n x n block whose top-left element is (row, col). No copy is made.
+		  * @throws MyOutOfRange if the block does not fit inside the matrix.
+		  */
+		 BasicSquareMatrixView<T> block(int row, int col, int n);
+
+		 /**
+		  * @brief Read-only view of the n x n block whose top-left element is (row, col).
+		  */
+		 BasicSquareMatrixView<T> block(int row, int col, int n) const;
+
+		 /**
+		  * @brief Writable view of the matrix without row `row` and column `col`. No copy is made.
+		  * @throws MyOutOfRange if an index is out of range.
+		  */
+		 BasicSquareMatrixView<T> minorView(int row, int col);
+
+		 /**
+		  * @brief Read-only view of the matrix without row `row` and column `col`.
+		  */
+		 BasicSquareMatrixView<T> minorView(int row, int col) const;
  
 		 // === Arithmetic Operators ===
  
-		 SquareMatrix operator+(const SquareMatrix& other) const; ///< Matrix addition
-		 SquareMatrix& operator+=(const SquareMatrix& other); ///< Matrix addition (in-place)
-		 SquareMatrix operator-(const SquareMatrix& other) const; ///< Matrix subtraction
-		 SquareMatrix& operator-=(const SquareMatrix& other); ///< Matrix subtraction (in-place)
-		 SquareMatrix operator*(const SquareMatrix& other) const; ///< Matrix multiplication
-		 SquareMatrix operator%(const SquareMatrix& other) const; ///< Element-wise multiplication
-		 SquareMatrix operator-() const; ///< Unary minus
-		 SquareMatrix operator*(double scalar) const; ///< Scalar multiplication
-		 SquareMatrix& operator*=(double scalar); ///< Scalar multiplication (in-place)
-		 SquareMatrix operator%(int scalar) const; ///< Scalar modulo
-		 SquareMatrix& operator%=(int scalar); ///< Scalar modulo (in-place)
-		 SquareMatrix operator/(double scalar) const; ///< Scalar division
-		 SquareMatrix& operator/=(double scalar); ///< Scalar division (in-place)
-		 SquareMatrix operator^(int power) const; ///< Matrix exponentiation
+		 BasicSquareMatrix operator+(const BasicSquareMatrix& other) const; ///< Matrix addition
+		 BasicSquareMatrix& operator+=(const BasicSquareMatrix& other); ///< Matrix addition (in-place)
+		 BasicSquareMatrix operator-(const BasicSquareMatrix& other) const; ///< Matrix subtraction
+		 BasicSquareMatrix& operator-=(const BasicSquareMatrix& other); ///< Matrix subtraction (in-place)
+		 BasicSquareMatrix operator*(const BasicSquareMatrix& other) const; ///< Matrix multiplication
+		 BasicSquareMatrix operator%(const BasicSquareMatrix& other) const; ///< Element-wise multiplication
+		 BasicSquareMatrix operator-() const; ///< Unary minus
+		 BasicSquareMatrix operator*(T scalar) const; ///< Scalar multiplication
+		 BasicSquareMatrix& operator*=(T scalar); ///< Scalar multiplication (in-place)
+		 BasicSquareMatrix operator%(int scalar) const; ///< Scalar modulo
+		 BasicSquareMatrix& operator%=(int scalar); ///< Scalar modulo (in-place)
+		 BasicSquareMatrix operator/(T scalar) const; ///< Scalar division
+		 BasicSquareMatrix& operator/=(T scalar); ///< Scalar division (in-place)
+		 BasicSquareMatrix operator^(int power) const; ///< Matrix exponentiation (negative powers use the inverse)
+		 VectorType operator*(const VectorType& vector) const; ///< Matrix-vector product (GEMV)
+
+		 /**
+		  * @brief Products of this matrix with `count` vectors at once (GEMM with a skinny right-hand side).
+		  *
+		  * Each tile of matrix rows is read once for all the vectors; the result owns the products.
+		  * @throws MyLogicError if count < 1, a size differs, or an operand is not fully initialized.
+		  */
+		 VectorList multiplyVectors(const VectorType* vectors, int count) const;
  
 		 // === Increment/Decrement ===
  
-		 SquareMatrix& operator++(); ///< Prefix increment (++mat)
-		 SquareMatrix operator++(int); ///< Postfix increment (mat++)
-		 SquareMatrix& operator--(); ///< Prefix decrement (--mat)
-		 SquareMatrix operator--(int); ///< Postfix decrement (mat--)
+		 BasicSquareMatrix& operator++(); ///< Prefix increment (++mat)
+		 BasicSquareMatrix operator++(int); ///< Postfix increment (mat++)
+		 BasicSquareMatrix& operator--(); ///< Prefix decrement (--mat)
+		 BasicSquareMatrix operator--(int); ///< Postfix decrement (mat--)
  
 		 // === Utility Operators ===
  
-		 SquareMatrix& operator~(); ///< Transpose matrix
-		 double operator!() const; ///< Determinant
+		 BasicSquareMatrix& operator~(); ///< Transpose matrix (O(1), materialized lazily)
+		 T operator!() const; ///< Determinant
+
+		 /**
+		  * @brief Frobenius norm: sqrt of the sum of squared magnitudes, reduced pairwise across rows.
+		  * @throws MyLogicError if the matrix is not fully initialized.
+		  */
+		 double frobeniusNorm() const;
+
+		 /**
+		  * @brief Computes the inverse matrix using in-place Gauss-Jordan elimination.
+		  * @throws MyLogicError if the matrix is not fully initialized or is singular.
+		  */
+		 BasicSquareMatrix inverse() const;
+
+		 /**
+		  * @brief Computes the Cholesky factor L (A = L * L^T) of a symmetric positive-definite matrix.
+		  * @return Lower-triangular matrix with zeros above the diagonal.
+		  * @throws MyLogicError if the matrix is uninitialized, not symmetric or not positive definite.
+		  */
+		 BasicSquareMatrix cholesky() const;
+
+		 /**
+		  * @brief Determinant of A computed from its Cholesky factor (product of squared diagonal).
+		  */
+		 static T choleskyDeterminant(const BasicSquareMatrix& factor);
+
+		 /**
+		  * @brief Solves A * x = rhs given the Cholesky factor L of A (forward then back substitution).
+		  * @throws MyLogicError if sizes do not match or rhs is not fully initialized.
+		  */
+		 static VectorType choleskySolve(const BasicSquareMatrix& factor, const VectorType& rhs);
+
+		 /**
+		  * @brief Householder QR factorization in compact (LAPACK geqrf-style) form.
+		  *
+		  * R is stored on and above the diagonal, the Householder vectors below it
+		  * (with an implicit unit leading entry). Q is never formed; use qrApplyQ
+		  * or qrSolve on the result, or qr() when an explicit Q is needed.
+		  * @param tau Output vector receiving the reflector scaling factors.
+		  * @throws MyLogicError if the matrix is not fully initialized.
+		  */
+		 BasicSquareMatrix householderQR(VectorType& tau) const;
+
+		 /**
+		  * @brief Computes Q * x (or Q^T * x when transpose is true) from a compact QR factor.
+		  */
+		 static VectorType qrApplyQ(const BasicSquareMatrix& factor, const VectorType& tau,
+										  const VectorType& x, bool transpose);
+
+		 /**
+		  * @brief Solves A * x = rhs in the least-squares sense from a compact QR factor.
+		  * @throws MyLogicError if sizes do not match or R is singular.
+		  */
+		 static VectorType qrSolve(const BasicSquareMatrix& factor, const VectorType& tau,
+										 const VectorType& rhs);
+
+		 /**
+		  * @brief Computes an explicit factorization A = Q * R.
+		  * @param q Output orthogonal matrix.
+		  * @param r Output upper-triangular matrix.
+		  */
+		 void qr(BasicSquareMatrix& q, BasicSquareMatrix& r) const;
+
+		 /**
+		  * @brief Eigenvalues of a symmetric matrix in ascending order (no eigenvectors are accumulated).
+		  * @throws MyLogicError if the matrix is uninitialized, not symmetric, or the iteration does not converge.
+		  */
+		 VectorType eigenvalues() const;
+
+		 /**
+		  * @brief Eigenvalues (ascending) and eigenvectors of a symmetric matrix.
+		  * @param eigenvectors Output matrix whose column j is the unit eigenvector of eigenvalue j.
+		  * @throws MyLogicError if the matrix is uninitialized, not symmetric, or the iteration does not converge.
+		  */
+		 VectorType eigen(BasicSquareMatrix& eigenvectors) const;
+
+		 /**
+		  * @brief Real power A^k of a symmetric matrix via its eigendecomposition, O(n^3) for any k.
+		  * @throws MyLogicError for a fractional power of a matrix with negative eigenvalues,
+		  *         or a negative power of a singular matrix.
+		  */
+		 BasicSquareMatrix power(double exponent) const;
  
 		 // === Comparison Operators (based on total sum of elements) ===
-		 bool operator==(const SquareMatrix& other) const {
-			return std::abs(this->sum() - other.sum()) < 1e-9;
+		 bool operator==(const BasicSquareMatrix& other) const {
+			return VectorGM::ElementTraits<T>::nearlyEqual(this->sum(), other.sum());
 		}
-		bool operator!=(const SquareMatrix& other) const {
+		bool operator!=(const BasicSquareMatrix& other) const {
 			return !(*this == other);
 		}
-		bool operator<(const SquareMatrix& other) const {
-			return this->sum() < other.sum();
+		bool operator<(const BasicSquareMatrix& other) const {
+			return VectorGM::ElementTraits<T>::less(this->sum(), other.sum());
 		}
-		bool operator>(const SquareMatrix& other) const {
-			return this->sum() > other.sum();
+		bool operator>(const BasicSquareMatrix& other) const {
+			return VectorGM::ElementTraits<T>::less(other.sum(), this->sum());
 		}
-		bool operator<=(const SquareMatrix& other) const {
+		bool operator<=(const BasicSquareMatrix& other) const {
 			return !(*this > other);
 		}
-		bool operator>=(const SquareMatrix& other) const {
+		bool operator>=(const BasicSquareMatrix& other) const {
 			return !(*this < other);
 		}
  
+		 // === Execution-Policy Overloads ===
+		 //
+		 // Same results as the operators, under an explicit policy from ExecutionPolicy.hpp:
+		 // `seq` stays on the calling thread, `par` splits rows across the shared scheduler
+		 // once tasks get enough elements, `par_unseq` also uses vectorizable raw-cell kernels.
+		 // Example: `SquareMatrix c = add(par, a, b);`
+
+		 /// a + b
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix add(Policy, const BasicSquareMatrix& a, const BasicSquareMatrix& b) {
+			 return a.plus(Policy::execution, b);
+		 }
+		 /// a - b
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix subtract(Policy, const BasicSquareMatrix& a, const BasicSquareMatrix& b) {
+			 return a.minus(Policy::execution, b);
+		 }
+		 /// a % b
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix multiplyElements(Policy, const BasicSquareMatrix& a, const BasicSquareMatrix& b) {
+			 return a.hadamard(Policy::execution, b);
+		 }
+		 /// -a
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix negative(Policy, const BasicSquareMatrix& a) {
+			 return a.negated(Policy::execution);
+		 }
+		 /// a += b
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& addTo(Policy, BasicSquareMatrix& a, const BasicSquareMatrix& b) {
+			 return a.addAssign(Policy::execution, b);
+		 }
+		 /// a -= b
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& subtractFrom(Policy, BasicSquareMatrix& a, const BasicSquareMatrix& b) {
+			 return a.subtractAssign(Policy::execution, b);
+		 }
+		 /// a *= scalar
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& scaleInPlace(Policy, BasicSquareMatrix& a, T scalar) {
+			 return a.scaleAssign(Policy::execution, scalar);
+		 }
+		 /// a /= scalar
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& divideInPlace(Policy, BasicSquareMatrix& a, T scalar) {
+			 return a.divideAssign(Policy::execution, scalar);
+		 }
+		 /// a %= scalar
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& moduloInPlace(Policy, BasicSquareMatrix& a, int scalar) {
+			 return a.moduloAssign(Policy::execution, scalar);
+		 }
+		 /// ++a
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& increment(Policy, BasicSquareMatrix& a) {
+			 return a.incrementAssign(Policy::execution);
+		 }
+		 /// --a
+		 template <typename Policy, std::enable_if_t<ParallelGM::IsExecutionPolicy<Policy>::value, int> = 0>
+		 friend BasicSquareMatrix& decrement(Policy, BasicSquareMatrix& a) {
+			 return a.decrementAssign(Policy::execution);
+		 }
+
 		 // === Output Operator ===
  
 		 /**
 		  * @brief Outputs matrix rows using std::ostream.
 		  */
-		 friend std::ostream& operator<<(std::ostream& os, const SquareMatrix& mat) {
+		 friend std::ostream& operator<<(std::ostream& os, const BasicSquareMatrix& mat) {
 			 for (int i = 0; i < mat.size; ++i)
 				 os << mat[i] << '\n';
 			 return os;
 		 }
 	 };
+
+	 using SquareMatrix = BasicSquareMatrix<double>;
  
  } // namespace SquareMatrixGM
  
  #endif
+
+ #include "SquareMatrixView.hpp"
  
\ No newline at end of file
@@ -0,0 +1,219 @@
+/**
+ * @file SquareMatrixBatch.cpp
+ * @brief Implements SquareMatrixBatch, a container of many same-sized square matrices.
+ *
+ * All kernels iterate over matrix elements in the outer loops and over the batch in
+ * the innermost loop, which is unit-stride thanks to the interleaved layout. These
+ * loops carry no branches, checks or logging, so the compiler vectorizes them across
+ * matrices.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "SquareMatrixBatch.hpp"
+#include <utility>
+#include "../Exception/MyExceptions.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Test_And_Log/Logger.hpp"
+
+using namespace VectorGM;
+
+namespace SquareMatrixGM {
+
+    SquareMatrixBatch::SquareMatrixBatch(int size, int count) : size(size), count(count) {
+        if (size < 0 || count < 0)
+            MATRIX_THROW(InvalidArgument());
+        LOG(LogLevel::DEBUG, "Batch constructor called with size = " << size << ", count = " << count);
+        std::size_t total = elements();
+        data = MemoryGM::allocateArray<double>(total);
+        for (std::size_t i = 0; i < total; ++i)
+            data[i] = 0.0;
+    }
+
+    SquareMatrixBatch::SquareMatrixBatch(const SquareMatrixBatch& other) : size(other.size), count(other.count) {
+        LOG(LogLevel::DEBUG, "Batch copy constructor called");
+        std::size_t total = elements();
+        data = MemoryGM::allocateArray<double>(total);
+        for (std::size_t i = 0; i < total; ++i)
+            data[i] = other.data[i];
+    }
+
+    SquareMatrixBatch& SquareMatrixBatch::operator=(const SquareMatrixBatch& other) {
+        LOG(LogLevel::DEBUG, "Batch assignment operator called");
+        if (this == &other) return *this;
+        std::size_t total = other.elements();
+        double* copy = MemoryGM::allocateArray<double>(total);
+        for (std::size_t i = 0; i < total; ++i)
+            copy[i] = other.data[i];
+        MemoryGM::releaseArray(data, elements());
+        data = copy;
+        size = other.size;
+        count = other.count;
+        return *this;
+    }
+
+    SquareMatrixBatch::SquareMatrixBatch(SquareMatrixBatch&& other) noexcept
+        : data(other.data), size(other.size), count(other.count) {
+        other.data = nullptr;
+        other.size = 0;
+        other.count = 0;
+    }
+
+    SquareMatrixBatch& SquareMatrixBatch::operator=(SquareMatrixBatch&& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    SquareMatrixBatch::~SquareMatrixBatch() {
+        LOG(LogLevel::DEBUG, "Batch destructor called");
+        MemoryGM::releaseArray(data, elements());
+    }
+
+    double& SquareMatrixBatch::at(int matrix, int row, int col) {
+        if (matrix < 0 || matrix >= count || row < 0 || row >= size || col < 0 || col >= size)
+            MATRIX_THROW(MyOutOfRange());
+        return data[offset(row, col) + matrix];
+    }
+
+    const double& SquareMatrixBatch::at(int matrix, int row, int col) const {
+        if (matrix < 0 || matrix >= count || row < 0 || row >= size || col < 0 || col >= size)
+            MATRIX_THROW(MyOutOfRange());
+        return data[offset(row, col) + matrix];
+    }
+
+    void SquareMatrixBatch::set(int matrix, const SquareMatrix& value) {
+        LOG(LogLevel::DEBUG, "Batch set() called for matrix " << matrix);
+        if (matrix < 0 || matrix >= count)
+            MATRIX_THROW(MyOutOfRange());
+        if (value.getSize() != size)
+            MATRIX_THROW(MyLogicError("Matrix size must match batch size"));
+        for (int i = 0; i < size; ++i) {
+            const Vector& row = value[i];
+            if (!row.allInitialized())
+                MATRIX_THROW(MyLogicError("Matrix must be fully initialized to be stored in a batch"));
+            for (int j = 0; j < size; ++j)
+                data[offset(i, j) + matrix] = row[j];
+        }
+    }
+
+    SquareMatrix SquareMatrixBatch::get(int matrix) const {
+        LOG(LogLevel::DEBUG, "Batch get() called for matrix " << matrix);
+        if (matrix < 0 || matrix >= count)
+            MATRIX_THROW(MyOutOfRange());
+        SquareMatrix result(size);
+        for (int i = 0; i < size; ++i) {
+            Cell* row = result[i].cells();
+            for (int j = 0; j < size; ++j) {
+                row[j].value = data[offset(i, j) + matrix];
+                row[j].initialized = true;
+            }
+        }
+        return result;
+    }
+
+   /**
+ * @brief Index of element (row, col) of the first matrix. Computed in std::size_t, since
+ * size * size * count overflows an int long before the batch runs out of memory.
+ */
+    std::size_t SquareMatrixBatch::offset(int row, int col) const {
+        return (static_cast<std::size_t>(row) * size + col) * count;
+    }
+
+    std::size_t SquareMatrixBatch::elements() const {
+        return static_cast<std::size_t>(size) * size * count;
+    }
+
+    int SquareMatrixBatch::getSize() const {
+        return size;
+    }
+
+    int SquareMatrixBatch::getCount() const {
+        return count;
+    }
+
+    SquareMatrixBatch SquareMatrixBatch::operator+(const SquareMatrixBatch& other) const {
+        LOG(LogLevel::DEBUG, "Batch operator+ called");
+        if (size != other.size || count != other.count)
+            MATRIX_THROW(MyLogicError("Batch dimensions must match for addition"));
+        SquareMatrixBatch result(size, count);
+        std::size_t total = elements();
+        const double* a = data;
+        const double* b = other.data;
+        double* c = result.data;
+        for (std::size_t i = 0; i < total; ++i)
+            c[i] = a[i] + b[i];
+        return result;
+    }
+
+   /**
+ * @brief Multiplies every matrix of this batch by the matching matrix of `other`.
+ *
+ * For each output element (i, j) the k-loop accumulates A(i, k) * B(k, j) into a
+ * lane-wide row of `count` results, so the innermost loop is a unit-stride
+ * multiply-add across all matrices of the batch.
+ */
+    SquareMatrixBatch SquareMatrixBatch::operator*(const SquareMatrixBatch& other) const {
+        LOG(LogLevel::DEBUG, "Batch operator* called");
+        if (size != other.size || count != other.count)
+            MATRIX_THROW(MyLogicError("Batch dimensions must match for multiplication"));
+        SquareMatrixBatch result(size, count);
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                double* c = result.data + offset(i, j);
+                for (int k = 0; k < size; ++k) {
+                    const double* a = data + offset(i, k);
+                    const double* b = other.data + offset(k, j);
+                    for (int m = 0; m < count; ++m)
+                        c[m] += a[m] * b[m];
+                }
+            }
+        }
+        return result;
+    }
+
+    SquareMatrixBatch& SquareMatrixBatch::operator~() {
+        LOG(LogLevel::DEBUG, "Batch operator~ (transpose) called");
+        for (int i = 0; i < size; ++i) {
+            for (int j = i + 1; j < size; ++j) {
+                double* upper = data + offset(i, j);
+                double* lower = data + offset(j, i);
+                for (int m = 0; m < count; ++m) {
+                    double tmp = upper[m];
+                    upper[m] = lower[m];
+                    lower[m] = tmp;
+                }
+            }
+        }
+        return *this;
+    }
+
+    SquareMatrixBatch SquareMatrixBatch::operator^(int power) const {
+        LOG(LogLevel::DEBUG, "Batch operator^ called with power = " << power);
+        if (power < 0)
+            MATRIX_THROW(MyLogicError("Batch power must be non-negative"));
+        SquareMatrixBatch result = identity(size, count);
+        SquareMatrixBatch base = *this;
+        while (power > 0) {
+            if (power % 2 == 1)
+                result = result * base;
+            power /= 2;
+            if (power > 0)
+                base = base * base;
+        }
+        return result;
+    }
+
+    SquareMatrixBatch SquareMatrixBatch::identity(int size, int count) {
+        SquareMatrixBatch result(size, count);
+        for (int i = 0; i < size; ++i) {
+            double* diag = result.data + result.offset(i, i);
+            for (int m = 0; m < count; ++m)
+                diag[m] = 1.0;
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,92 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Definition of the SquareMatrixBatch class for many small square matrices.
+ *
+ * A batch stores `count` matrices of the same size `n` in one contiguous array using
+ * an interleaved structure-of-arrays layout: element (row, col) of every matrix is
+ * stored next to the same element of the other matrices, at index
+ * `(row * n + col) * count + matrix`. The innermost loop of every kernel therefore
+ * runs across matrices, so SIMD lanes span matrices rather than elements and even a
+ * 2x2 or 3x3 product vectorizes fully.
+ *
+ * Unlike SquareMatrix, a batch does not track cell initialization and its kernels do
+ * not log per element; all cells start at zero.
+ */
+
+#ifndef SQUARE_MATRIX_BATCH_HPP
+#define SQUARE_MATRIX_BATCH_HPP
+
+#include <cstddef>
+#include "SquareMatrix.hpp"
+
+namespace SquareMatrixGM {
+
+	/**
+	 * @class SquareMatrixBatch
+	 * @brief K square matrices of size n stored interleaved for batched arithmetic.
+	 */
+	class SquareMatrixBatch {
+	private:
+		double* data; ///< size * size * count values, interleaved by matrix
+		int size;     ///< Dimension of every matrix (NxN)
+		int count;    ///< Number of matrices in the batch
+
+		static SquareMatrixBatch identity(int size, int count); ///< Batch of identity matrices.
+		std::size_t offset(int row, int col) const; ///< Index of element (row, col) of matrix 0
+		std::size_t elements() const; ///< size * size * count
+
+	public:
+		// === Constructors and Destructor ===
+
+		/**
+		 * @brief Constructs a batch of `count` zero matrices of dimension `size`.
+		 * @throws InvalidArgument if size or count is negative.
+		 */
+		SquareMatrixBatch(int size, int count);
+
+		SquareMatrixBatch(const SquareMatrixBatch& other); ///< Copy constructor
+		SquareMatrixBatch& operator=(const SquareMatrixBatch& other); ///< Copy assignment
+		SquareMatrixBatch(SquareMatrixBatch&& other) noexcept; ///< Move constructor: takes the buffer, leaves `other` empty
+		SquareMatrixBatch& operator=(SquareMatrixBatch&& other) noexcept; ///< Move assignment: swaps the buffers
+		~SquareMatrixBatch(); ///< Destructor
+
+		// === Element Access ===
+
+		/**
+		 * @brief Accesses element (row, col) of matrix `matrix` (modifiable).
+		 * @throws MyOutOfRange if any index is out of range.
+		 */
+		double& at(int matrix, int row, int col);
+
+		/**
+		 * @brief Accesses element (row, col) of matrix `matrix` (read-only).
+		 * @throws MyOutOfRange if any index is out of range.
+		 */
+		const double& at(int matrix, int row, int col) const;
+
+		/**
+		 * @brief Copies a fully initialized SquareMatrix into slot `matrix`.
+		 * @throws MyLogicError if the sizes differ or the matrix is not fully initialized.
+		 */
+		void set(int matrix, const SquareMatrix& value);
+
+		/**
+		 * @brief Returns slot `matrix` as a SquareMatrix.
+		 */
+		SquareMatrix get(int matrix) const;
+
+		int getSize() const;  ///< Dimension of every matrix
+		int getCount() const; ///< Number of matrices
+
+		// === Batched Operators ===
+
+		SquareMatrixBatch operator+(const SquareMatrixBatch& other) const; ///< Batched addition
+		SquareMatrixBatch operator*(const SquareMatrixBatch& other) const; ///< Batched matrix multiplication
+		SquareMatrixBatch& operator~(); ///< Transposes every matrix in place
+		SquareMatrixBatch operator^(int power) const; ///< Batched exponentiation by squaring
+	};
+
+} // namespace SquareMatrixGM
+
+#endif
@@ -0,0 +1,507 @@
+/**
+ * @file SquareMatrixView.cpp
+ * @brief Implements BasicSquareMatrixView, the non-owning block and minor view of a matrix.
+ *
+ * A view maps its (row, col) to a cell of the viewed matrix: undo the view's own
+ * transpose, step over the rows/columns skipped by (nested) minors, add the block
+ * offsets, and finally follow the matrix's lazy-transpose flag. Elements are reached
+ * through the rows' raw cells, so view kernels neither allocate per element nor log
+ * per access; element-wise kernels read both operands in place and copy the source
+ * only when it overlaps the view being written.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "SquareMatrixView.hpp"
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include "../Exception/MyExceptions.hpp"
+#include "../Test_And_Log/Logger.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Vector/Reduction.hpp"
+
+using namespace VectorGM;
+
+namespace SquareMatrixGM {
+
+    template <typename T>
+    int BasicSquareMatrixView<T>::Axis::map(int index) const {
+        for (int k = 0; k < skipCount && skips[k] <= index; ++k)
+            ++index;
+        return offset + index;
+    }
+
+   /**
+ * @brief Re-bases the axis onto the view indices [start, start + n). Skips before the
+ * first covered index become part of the offset; skips after the last one disappear.
+ */
+    template <typename T>
+    void BasicSquareMatrixView<T>::Axis::narrow(int start, int n) {
+        int first = map(start) - offset;
+        int last = n > 0 ? map(start + n - 1) - offset : first;
+        int kept = 0;
+        for (int k = 0; k < skipCount; ++k)
+            if (skips[k] > first && skips[k] < last)
+                skips[kept++] = skips[k] - first;
+        skipCount = kept;
+        offset += first;
+    }
+
+    template <typename T>
+    void BasicSquareMatrixView<T>::Axis::skip(int index) {
+        if (skipCount == MAX_SKIPS)
+            MATRIX_THROW(MyLogicError("Too many nested minors for one view"));
+        int skipped = map(index) - offset;
+        int k = skipCount++;
+        for (; k > 0 && skips[k - 1] > skipped; --k)
+            skips[k] = skips[k - 1];
+        skips[k] = skipped;
+    }
+
+    template <typename T>
+    bool BasicSquareMatrixView<T>::Axis::operator==(const Axis& other) const {
+        if (offset != other.offset || skipCount != other.skipCount)
+            return false;
+        for (int k = 0; k < skipCount; ++k)
+            if (skips[k] != other.skips[k])
+                return false;
+        return true;
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>::BasicSquareMatrixView(MatrixType* matrix, int size, bool readOnly)
+        : matrix(matrix), rowAxis{0, 0, {}}, colAxis{0, 0, {}}, size(size), readOnly(readOnly), swapped(false) {}
+
+    template <typename T>
+    BasicSquareMatrixView<T>::BasicSquareMatrixView(MatrixType& matrix)
+        : BasicSquareMatrixView(&matrix, matrix.size, false) {}
+
+    template <typename T>
+    BasicSquareMatrixView<T>::BasicSquareMatrixView(const MatrixType& matrix)
+        : BasicSquareMatrixView(const_cast<MatrixType*>(&matrix), matrix.size, true) {}
+
+    template <typename T>
+    BasicCell<T>& BasicSquareMatrixView<T>::cell(int row, int col) const {
+        int r = rowAxis.map(swapped ? col : row);
+        int c = colAxis.map(swapped ? row : col);
+        if (matrix->transposed)
+            std::swap(r, c);
+        return matrix->rows[r].cells()[c];
+    }
+
+    template <typename T>
+    void BasicSquareMatrixView<T>::checkIndex(int row, int col) const {
+        if (row < 0 || row >= size || col < 0 || col >= size)
+            MATRIX_THROW(MyOutOfRange());
+    }
+
+    template <typename T>
+    void BasicSquareMatrixView<T>::prepareWrite() const {
+        if (readOnly)
+            MATRIX_THROW(MyLogicError("Cannot write through a view of a const matrix"));
+        matrix->detach();
+        matrix->noteWrite();
+    }
+
+    template <typename T>
+    MemoryGM::ScratchArray<T> BasicSquareMatrixView<T>::gather(const char* operation) const {
+        MemoryGM::ScratchArray<T> buffer(static_cast<std::size_t>(size) * size);
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j) {
+                const BasicCell<T>& c = cell(i, j);
+                if (!c.initialized)
+                    MATRIX_THROW(MyLogicError(operation));
+                buffer[static_cast<std::size_t>(i) * size + j] = c.value;
+            }
+        return buffer;
+    }
+
+   /**
+ * @brief Whether `other` may change while this view is written, so it must be copied first.
+ *
+ * Only a view of the same matrix object can: a matrix sharing its rows is detached by
+ * prepareWrite() before the first write. A view with exactly the same mapping is safe
+ * too, since each element is read before it is written; otherwise the regions' bounding
+ * boxes decide.
+ */
+    template <typename T>
+    bool BasicSquareMatrixView<T>::overlaps(const BasicSquareMatrixView& other) const {
+        if (matrix != other.matrix)
+            return false;
+        if (swapped == other.swapped && rowAxis == other.rowAxis && colAxis == other.colAxis)
+            return false;
+        auto intersect = [](int a, int aSpan, int b, int bSpan) { return a < b + bSpan && b < a + aSpan; };
+        return intersect(rowAxis.offset, rowAxis.span(size), other.rowAxis.offset, other.rowAxis.span(other.size)) &&
+               intersect(colAxis.offset, colAxis.span(size), other.colAxis.offset, other.colAxis.span(other.size));
+    }
+
+    template <typename T>
+    void BasicSquareMatrixView<T>::requireSameSize(const BasicSquareMatrixView& other, const char* operation) const {
+        if (size != other.size)
+            MATRIX_THROW(MyLogicError(operation));
+    }
+
+    template <typename T>
+    template <typename Func>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::updateEach(Func func, const char* operation) {
+        prepareWrite();
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j) {
+                BasicCell<T>& c = cell(i, j);
+                if (!c.initialized)
+                    MATRIX_THROW(MyLogicError(operation));
+                c.value = func(i, j, c.value);
+            }
+        return *this;
+    }
+
+   /**
+ * @brief this = func(this, other) element by element, reading `other` in place unless it
+ * overlaps this view. Both operands are checked before anything is written.
+ */
+    template <typename T>
+    template <typename Func>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::updateWith(const BasicSquareMatrixView& other, Func func,
+                                                                   const char* operation) {
+        if (overlaps(other)) {
+            MemoryGM::ScratchArray<T> gathered = other.gather(operation);
+            const T* source = gathered.get();
+            int n = size;
+            return updateEach([source, n, &func](int i, int j, T v) { return func(v, source[i * n + j]); }, operation);
+        }
+        prepareWrite();
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j)
+                if (!cell(i, j).initialized || !other.cell(i, j).initialized)
+                    MATRIX_THROW(MyLogicError(operation));
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j) {
+                BasicCell<T>& c = cell(i, j);
+                c.value = func(c.value, other.cell(i, j).value);
+            }
+        return *this;
+    }
+
+    template <typename T>
+    template <typename Func>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::mapEach(Func func, const char* operation) const {
+        MatrixType result(size);
+        for (int i = 0; i < size; ++i) {
+            BasicCell<T>* out = result.rows[i].cells();
+            for (int j = 0; j < size; ++j) {
+                const BasicCell<T>& c = cell(i, j);
+                if (!c.initialized)
+                    MATRIX_THROW(MyLogicError(operation));
+                out[j].value = func(i, j, c.value);
+                out[j].initialized = true;
+            }
+        }
+        return result;
+    }
+
+   /**
+ * @brief Builds a matrix of func(this, other) element by element, reading both views in place.
+ */
+    template <typename T>
+    template <typename Func>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::mapWith(const BasicSquareMatrixView& other,
+                                                                                    Func func, const char* operation) const {
+        MatrixType result(size);
+        for (int i = 0; i < size; ++i) {
+            BasicCell<T>* out = result.rows[i].cells();
+            for (int j = 0; j < size; ++j) {
+                const BasicCell<T>& a = cell(i, j);
+                const BasicCell<T>& b = other.cell(i, j);
+                if (!a.initialized || !b.initialized)
+                    MATRIX_THROW(MyLogicError(operation));
+                out[j].value = func(a.value, b.value);
+                out[j].initialized = true;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    T BasicSquareMatrixView<T>::get(int row, int col) const {
+        checkIndex(row, col);
+        return cell(row, col).value;
+    }
+
+    template <typename T>
+    void BasicSquareMatrixView<T>::set(int row, int col, T value) {
+        checkIndex(row, col);
+        prepareWrite();
+        BasicCell<T>& c = cell(row, col);
+        c.value = value;
+        c.initialized = true;
+    }
+
+    template <typename T>
+    bool BasicSquareMatrixView<T>::isInitialized(int row, int col) const {
+        checkIndex(row, col);
+        return cell(row, col).initialized;
+    }
+
+    template <typename T>
+    int BasicSquareMatrixView<T>::getSize() const {
+        return size;
+    }
+
+    template <typename T>
+    bool BasicSquareMatrixView<T>::isReadOnly() const {
+        return readOnly;
+    }
+
+   /**
+ * @brief Narrows the view to an n x n block. Offsets and skips compose, so a block of a
+ * minor (or of a transposed view) still addresses the matrix cells directly.
+ */
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrixView<T>::block(int row, int col, int n) const {
+        LOG(LogLevel::DEBUG, "View block() called for row = " << row << ", col = " << col << ", n = " << n);
+        if (n < 0 || row < 0 || col < 0 || row + n > size || col + n > size)
+            MATRIX_THROW(MyOutOfRange());
+        BasicSquareMatrixView result = *this;
+        result.size = n;
+        result.rowAxis.narrow(swapped ? col : row, n);
+        result.colAxis.narrow(swapped ? row : col, n);
+        return result;
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrixView<T>::minorView(int row, int col) const {
+        LOG(LogLevel::DEBUG, "View minorView() called for row = " << row << ", col = " << col);
+        checkIndex(row, col);
+        BasicSquareMatrixView result = *this;
+        result.size = size - 1;
+        result.rowAxis.skip(swapped ? col : row);
+        result.colAxis.skip(swapped ? row : col);
+        return result;
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::toMatrix() const {
+        LOG(LogLevel::DEBUG, "View toMatrix() called");
+        MatrixType result(size);
+        for (int i = 0; i < size; ++i) {
+            BasicCell<T>* out = result.rows[i].cells();
+            for (int j = 0; j < size; ++j)
+                out[j] = cell(i, j);
+        }
+        return result;
+    }
+
+   /**
+ * @brief Copies `other` into this view. A source overlapping this view is gathered first,
+ * so a view may be assigned from an overlapping view of the same matrix; any other
+ * source is copied cell to cell.
+ */
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::assign(const BasicSquareMatrixView& other) {
+        LOG(LogLevel::DEBUG, "View assign() called");
+        requireSameSize(other, "View sizes must match for assignment");
+        if (!overlaps(other)) {
+            for (int i = 0; i < size; ++i)
+                for (int j = 0; j < size; ++j)
+                    if (!other.cell(i, j).initialized)
+                        MATRIX_THROW(MyLogicError("Source view must be fully initialized for assignment"));
+            prepareWrite();
+            for (int i = 0; i < size; ++i)
+                for (int j = 0; j < size; ++j)
+                    cell(i, j) = other.cell(i, j);
+            return *this;
+        }
+        MemoryGM::ScratchArray<T> source = other.gather("Source view must be fully initialized for assignment");
+        prepareWrite();
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j) {
+                BasicCell<T>& c = cell(i, j);
+                c.value = source[static_cast<std::size_t>(i) * size + j];
+                c.initialized = true;
+            }
+        return *this;
+    }
+
+   /**
+ * @brief Sum of all elements, added like BasicSquareMatrix::sum(): each row pairwise,
+ * then the row sums pairwise, so a view of a whole matrix compares equal to it.
+ */
+    template <typename T>
+    T BasicSquareMatrixView<T>::sum() const {
+        auto rowSum = [this](int i) {
+            return VectorGM::pairwiseReduce<T>(0, size, [this, i](int j) {
+                const BasicCell<T>& c = cell(i, j);
+                if (!c.initialized)
+                    MATRIX_THROW(MyLogicError("Uninitialized cell in view during sum()"));
+                return c.value;
+            });
+        };
+        return VectorGM::pairwiseReduce<T>(0, size, rowSum);
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator+(const BasicSquareMatrixView& other) const {
+        LOG(LogLevel::DEBUG, "View operator+ called");
+        requireSameSize(other, "Matrix sizes must match for addition");
+        return mapWith(other, [](T a, T b) { return a + b; }, "Both views must be fully initialized for addition");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator-(const BasicSquareMatrixView& other) const {
+        LOG(LogLevel::DEBUG, "View operator- called");
+        requireSameSize(other, "Matrix sizes must match for subtraction");
+        return mapWith(other, [](T a, T b) { return a - b; }, "Both views must be fully initialized for subtraction");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator%(const BasicSquareMatrixView& other) const {
+        LOG(LogLevel::DEBUG, "View operator% (element-wise) called");
+        requireSameSize(other, "Matrix sizes must match for element-wise multiplication");
+        return mapWith(other, [](T a, T b) { return a * b; }, "Both views must be fully initialized for element-wise multiplication");
+    }
+
+   /**
+ * @brief Multiplies two views in i-k-j order. The right operand, whose rows the inner loop
+ * streams, is gathered into a contiguous array once, so strided or skipped views cost the
+ * same as whole matrices; each left element is read once, in place.
+ */
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator*(const BasicSquareMatrixView& other) const {
+        LOG(LogLevel::DEBUG, "View operator* called");
+        requireSameSize(other, "Matrix sizes must match for multiplication");
+        int n = size;
+        for (int i = 0; i < n; ++i)
+            for (int k = 0; k < n; ++k)
+                if (!cell(i, k).initialized)
+                    MATRIX_THROW(MyLogicError("Both views must be fully initialized for multiplication"));
+        MemoryGM::ScratchArray<T> right = other.gather("Both views must be fully initialized for multiplication");
+        const T* b = right.get();
+        MatrixType result(n);
+        MemoryGM::ScratchArray<T> acc(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j)
+                acc[j] = T();
+            for (int k = 0; k < n; ++k) {
+                T aik = cell(i, k).value;
+                const T* bk = b + k * n;
+                for (int j = 0; j < n; ++j)
+                    acc[j] += aik * bk[j];
+            }
+            BasicCell<T>* out = result.rows[i].cells();
+            for (int j = 0; j < n; ++j) {
+                out[j].value = acc[j];
+                out[j].initialized = true;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator-() const {
+        LOG(LogLevel::DEBUG, "View unary operator- called");
+        return mapEach([](int, int, T v) { return -v; }, "Cannot negate uninitialized cell in view");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator*(T scalar) const {
+        LOG(LogLevel::DEBUG, "View operator* (scalar) called");
+        return mapEach([scalar](int, int, T v) { return v * scalar; }, "Cannot multiply uninitialized cell");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator%(int scalar) const {
+        LOG(LogLevel::DEBUG, "View operator% (scalar) called");
+        if (scalar == 0)
+            MATRIX_THROW(MyLogicError("Modulo by zero"));
+        return mapEach([scalar](int, int, T v) { return ElementTraits<T>::modulo(v, scalar); },
+                       "Cannot modulo uninitialized cell");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator/(T scalar) const {
+        LOG(LogLevel::DEBUG, "View operator/ called");
+        if (scalar == T())
+            MATRIX_THROW(MyLogicError("Division by zero"));
+        return mapEach([scalar](int, int, T v) { return v / scalar; }, "Cannot divide uninitialized cell");
+    }
+
+    template <typename T>
+    typename BasicSquareMatrixView<T>::MatrixType BasicSquareMatrixView<T>::operator^(int power) const {
+        LOG(LogLevel::DEBUG, "View operator^ called with power = " << power);
+        return toMatrix() ^ power;
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator+=(const BasicSquareMatrixView& other) {
+        LOG(LogLevel::DEBUG, "View operator+= called");
+        requireSameSize(other, "Matrix sizes must match for addition");
+        return updateWith(other, [](T a, T b) { return a + b; }, "Both views must be fully initialized for addition");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator-=(const BasicSquareMatrixView& other) {
+        LOG(LogLevel::DEBUG, "View operator-= called");
+        requireSameSize(other, "Matrix sizes must match for subtraction");
+        return updateWith(other, [](T a, T b) { return a - b; }, "Both views must be fully initialized for subtraction");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator*=(T scalar) {
+        LOG(LogLevel::DEBUG, "View operator*= called");
+        return updateEach([scalar](int, int, T v) { return v * scalar; }, "Cannot multiply uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator%=(int scalar) {
+        LOG(LogLevel::DEBUG, "View operator%= called");
+        if (scalar == 0)
+            MATRIX_THROW(MyLogicError("Modulo by zero"));
+        return updateEach([scalar](int, int, T v) { return ElementTraits<T>::modulo(v, scalar); },
+                          "Cannot modulo uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator/=(T scalar) {
+        LOG(LogLevel::DEBUG, "View operator/= called");
+        if (scalar == T())
+            MATRIX_THROW(MyLogicError("Division by zero"));
+        return updateEach([scalar](int, int, T v) { return v / scalar; }, "Cannot divide uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator++() {
+        LOG(LogLevel::DEBUG, "View operator++ called");
+        return updateEach([](int, int, T v) { return v + T(1); }, "Cannot increment uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T>& BasicSquareMatrixView<T>::operator--() {
+        LOG(LogLevel::DEBUG, "View operator-- called");
+        return updateEach([](int, int, T v) { return v - T(1); }, "Cannot decrement uninitialized cell");
+    }
+
+    template <typename T>
+    BasicSquareMatrixView<T> BasicSquareMatrixView<T>::operator~() const {
+        LOG(LogLevel::DEBUG, "View operator~ called");
+        BasicSquareMatrixView result = *this;
+        result.swapped = !swapped;
+        return result;
+    }
+
+    template <typename T>
+    T BasicSquareMatrixView<T>::operator!() const {
+        LOG(LogLevel::DEBUG, "View operator! (determinant) called");
+        MemoryGM::ScratchArray<T> work = gather("Matrix must be fully initialized to compute determinant");
+        return MatrixType::determinant(work.get(), size);
+    }
+
+    // Explicit instantiations, matching BasicSquareMatrix.
+    template class BasicSquareMatrixView<float>;
+    template class BasicSquareMatrixView<double>;
+    template class BasicSquareMatrixView<int32_t>;
+    template class BasicSquareMatrixView<int64_t>;
+    template class BasicSquareMatrixView<std::complex<double>>;
+
+} // namespace SquareMatrixGM
@@ -0,0 +1,228 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Definition of the BasicSquareMatrixView class template, a non-owning window on a matrix.
+ *
+ * A view addresses a square region of a BasicSquareMatrix without copying it: either a
+ * contiguous block (`block(row, col, n)`) or the matrix with one row and one column
+ * removed (`minorView(row, col)`), optionally transposed. Element reads and writes go
+ * straight to the cells of the viewed matrix, so creating a view costs no allocation.
+ *
+ * Views created from a non-const matrix are writable; like the mutable operator[] they
+ * stop the matrix from sharing its rows with later copies, and writing through them
+ * invalidates its cached sum. Views created from a const matrix are read-only and throw
+ * MyLogicError on writes. A view does not keep its matrix alive and must not outlive it.
+ *
+ * Binary operators accept any mix of views and matrices and return a new matrix;
+ * in-place operators write through the view.
+ */
+
+#ifndef SQUARE_MATRIX_VIEW_HPP
+#define SQUARE_MATRIX_VIEW_HPP
+
+#include <ostream>
+#include "SquareMatrix.hpp"
+
+namespace SquareMatrixGM {
+
+	/**
+	 * @class BasicSquareMatrixView
+	 * @brief Non-owning square block or minor of a BasicSquareMatrix.
+	 */
+	template <typename T>
+	class BasicSquareMatrixView {
+	public:
+		using MatrixType = BasicSquareMatrix<T>; ///< Viewed matrix type
+		using value_type = T; ///< Element type
+
+		static constexpr int MAX_SKIPS = 8; ///< Nested minors a view can take
+
+	private:
+		/**
+		 * @brief How one axis of the view maps onto matrix indices.
+		 */
+		struct Axis {
+			int offset;           ///< First matrix index covered by the view
+			int skipCount;        ///< Matrix indices skipped by (nested) minors
+			int skips[MAX_SKIPS]; ///< The skipped indices, relative to offset, ascending
+
+			int map(int index) const; ///< Matrix index of view index `index`
+			int span(int size) const { return size + skipCount; } ///< Matrix indices from offset to the last covered one
+			void narrow(int start, int n); ///< Re-bases the axis onto view indices [start, start + n)
+			void skip(int index); ///< Also skips view index `index`
+			bool operator==(const Axis& other) const; ///< Same offset and skips
+		};
+
+		MatrixType* matrix; ///< Viewed matrix (not owned)
+		Axis rowAxis;       ///< Matrix rows covered by the view
+		Axis colAxis;       ///< Matrix columns covered by the view
+		int size;           ///< Dimension of the view (NxN)
+		bool readOnly;      ///< Created from a const matrix
+		bool swapped;       ///< View is the transpose of the region it covers
+
+		BasicSquareMatrixView(MatrixType* matrix, int size, bool readOnly);
+
+		VectorGM::BasicCell<T>& cell(int row, int col) const; ///< Cell of the matrix behind view element (row, col).
+		void checkIndex(int row, int col) const; ///< Throws MyOutOfRange for indices outside the view.
+		void prepareWrite() const; ///< Rejects read-only views, detaches shared rows and drops the cached sum.
+		MemoryGM::ScratchArray<T> gather(const char* operation) const; ///< Copies the fully initialized view into a new, accounted row-major array.
+		bool overlaps(const BasicSquareMatrixView& other) const; ///< Whether writing this view may change `other` mid-kernel.
+		void requireSameSize(const BasicSquareMatrixView& other, const char* operation) const;
+
+		template <typename Func>
+		BasicSquareMatrixView& updateEach(Func func, const char* operation); ///< Applies func to every element in place.
+
+		template <typename Func>
+		BasicSquareMatrixView& updateWith(const BasicSquareMatrixView& other, Func func, const char* operation); ///< this = func(this, other), element-wise.
+
+		template <typename Func>
+		MatrixType mapEach(Func func, const char* operation) const; ///< Builds a matrix from func of every element.
+
+		template <typename Func>
+		MatrixType mapWith(const BasicSquareMatrixView& other, Func func, const char* operation) const; ///< func(this, other), element-wise.
+
+	public:
+		/**
+		 * @brief Writable view of a whole matrix.
+		 */
+		explicit BasicSquareMatrixView(MatrixType& matrix);
+
+		/**
+		 * @brief Read-only view of a whole matrix.
+		 */
+		BasicSquareMatrixView(const MatrixType& matrix);
+
+		// === Element Access ===
+
+		/**
+		 * @brief Reads element (row, col) of the view.
+		 * @throws MyOutOfRange if an index is out of range.
+		 */
+		T get(int row, int col) const;
+
+		/**
+		 * @brief Writes element (row, col) of the view and marks it initialized.
+		 * @throws MyOutOfRange if an index is out of range, MyLogicError if the view is read-only.
+		 */
+		void set(int row, int col, T value);
+
+		/**
+		 * @brief Checks whether element (row, col) has been initialized.
+		 */
+		bool isInitialized(int row, int col) const;
+
+		int getSize() const; ///< Dimension of the view
+		bool isReadOnly() const; ///< True for views of a const matrix
+
+		// === Sub-views ===
+
+		/**
+		 * @brief View of the n x n block whose top-left element is (row, col) of this view.
+		 * @throws MyOutOfRange if the block does not fit inside this view.
+		 */
+		BasicSquareMatrixView block(int row, int col, int n) const;
+
+		/**
+		 * @brief View of this view without row `row` and column `col`. Minors nest, up to MAX_SKIPS deep.
+		 * @throws MyOutOfRange if an index is out of range, MyLogicError past MAX_SKIPS nested minors.
+		 */
+		BasicSquareMatrixView minorView(int row, int col) const;
+
+		/**
+		 * @brief Copies the view into a new, independent matrix (uninitialized cells stay uninitialized).
+		 */
+		MatrixType toMatrix() const;
+
+		/**
+		 * @brief Copies every element of `other` into this view. Overlapping views are handled.
+		 * @throws MyLogicError if the sizes differ, the view is read-only or `other` is not fully initialized.
+		 */
+		BasicSquareMatrixView& assign(const BasicSquareMatrixView& other);
+
+		T sum() const; ///< Sum of all elements
+
+		// === Arithmetic Operators ===
+
+		MatrixType operator+(const BasicSquareMatrixView& other) const; ///< Matrix addition
+		MatrixType operator-(const BasicSquareMatrixView& other) const; ///< Matrix subtraction
+		MatrixType operator*(const BasicSquareMatrixView& other) const; ///< Matrix multiplication
+		MatrixType operator%(const BasicSquareMatrixView& other) const; ///< Element-wise multiplication
+		MatrixType operator-() const; ///< Unary minus
+		MatrixType operator*(T scalar) const; ///< Scalar multiplication
+		MatrixType operator%(int scalar) const; ///< Scalar modulo
+		MatrixType operator/(T scalar) const; ///< Scalar division
+		MatrixType operator^(int power) const; ///< Matrix exponentiation
+
+		BasicSquareMatrixView& operator+=(const BasicSquareMatrixView& other); ///< Addition through the view
+		BasicSquareMatrixView& operator-=(const BasicSquareMatrixView& other); ///< Subtraction through the view
+		BasicSquareMatrixView& operator*=(T scalar); ///< Scalar multiplication through the view
+		BasicSquareMatrixView& operator%=(int scalar); ///< Scalar modulo through the view
+		BasicSquareMatrixView& operator/=(T scalar); ///< Scalar division through the view
+		BasicSquareMatrixView& operator++(); ///< Adds 1 to every element through the view
+		BasicSquareMatrixView& operator--(); ///< Subtracts 1 from every element through the view
+
+		// === Utility Operators ===
+
+		BasicSquareMatrixView operator~() const; ///< Transposed view of the same region (O(1))
+		T operator!() const; ///< Determinant
+
+		// === Comparison Operators (based on total sum of elements) ===
+		bool operator==(const BasicSquareMatrixView& other) const {
+			return VectorGM::ElementTraits<T>::nearlyEqual(sum(), other.sum());
+		}
+		bool operator!=(const BasicSquareMatrixView& other) const {
+			return !(*this == other);
+		}
+		bool operator<(const BasicSquareMatrixView& other) const {
+			return VectorGM::ElementTraits<T>::less(sum(), other.sum());
+		}
+		bool operator>(const BasicSquareMatrixView& other) const {
+			return VectorGM::ElementTraits<T>::less(other.sum(), sum());
+		}
+		bool operator<=(const BasicSquareMatrixView& other) const {
+			return !(*this > other);
+		}
+		bool operator>=(const BasicSquareMatrixView& other) const {
+			return !(*this < other);
+		}
+
+		/**
+		 * @brief Outputs the view row by row, like a matrix.
+		 */
+		friend std::ostream& operator<<(std::ostream& os, const BasicSquareMatrixView& view) {
+			for (int i = 0; i < view.size; ++i) {
+				for (int j = 0; j < view.size; ++j) {
+					if (view.isInitialized(i, j))
+						os << view.get(i, j) << " ";
+					else
+						os << "[ ] ";
+				}
+				os << '\n';
+			}
+			return os;
+		}
+	};
+
+	// Matrix on the left, view on the right: the matrix member operators only accept matrices.
+	template <typename T>
+	BasicSquareMatrix<T> operator+(const BasicSquareMatrix<T>& a, const BasicSquareMatrixView<T>& b) {
+		return BasicSquareMatrixView<T>(a) + b;
+	}
+	template <typename T>
+	BasicSquareMatrix<T> operator-(const BasicSquareMatrix<T>& a, const BasicSquareMatrixView<T>& b) {
+		return BasicSquareMatrixView<T>(a) - b;
+	}
+	template <typename T>
+	BasicSquareMatrix<T> operator*(const BasicSquareMatrix<T>& a, const BasicSquareMatrixView<T>& b) {
+		return BasicSquareMatrixView<T>(a) * b;
+	}
+	template <typename T>
+	BasicSquareMatrix<T> operator%(const BasicSquareMatrix<T>& a, const BasicSquareMatrixView<T>& b) {
+		return BasicSquareMatrixView<T>(a) % b;
+	}
+
+	using SquareMatrixView = BasicSquareMatrixView<double>;
+
+} // namespace SquareMatrixGM
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file HugePages.cpp
+ * @brief Implements the huge-page backed allocator and its statistics.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "HugePages.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "MemoryAccounting.hpp"
+#include "../Exception/MyExceptions.hpp"
+
+namespace MemoryGM {
+
+    namespace {
+        struct Region {
+            std::size_t length; ///< Mapped bytes (a multiple of HUGE_PAGE_SIZE)
+            bool hugetlbfs;     ///< Mapped from a hugetlbfs file
+        };
+
+        /// Live large buffers by start address; small buffers are never recorded.
+        struct Registry {
+            std::mutex mutex;
+            std::map<std::uintptr_t, Region> regions;
+            std::atomic<std::size_t> threshold;
+            std::string hugetlbfs;
+
+            Registry() : threshold(HUGE_PAGE_SIZE) {
+                if (const char* env = std::getenv("MATRIX_HUGETLBFS"))
+                    hugetlbfs = env;
+            }
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        std::size_t roundUp(std::size_t bytes) {
+            return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+
+#ifdef __linux__
+        /// Maps `length` bytes from an unlinked file in `directory`; nullptr on any failure.
+        void* mapHugetlbfs(const std::string& directory, std::size_t length) {
+            std::string name = directory + "/matrixXXXXXX";
+            int fd = mkstemp(&name[0]);
+            if (fd < 0)
+                return nullptr;
+            unlink(name.c_str());
+            void* memory = nullptr;
+            if (ftruncate(fd, static_cast<off_t>(length)) == 0) {
+                memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (memory == MAP_FAILED)
+                    memory = nullptr;
+            }
+            close(fd);
+            return memory;
+        }
+
+        /// Maps `length` anonymous bytes on a 2 MiB boundary and asks for transparent huge pages.
+        void* mapAnonymous(std::size_t length) {
+            std::size_t padded = length + HUGE_PAGE_SIZE;
+            void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+                MATRIX_THROW(std::bad_alloc());
+            std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+            std::uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+            if (aligned > start)
+                munmap(raw, aligned - start);
+            std::size_t tail = start + padded - (aligned + length);
+            if (tail > 0)
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            void* memory = reinterpret_cast<void*>(aligned);
+            madvise(memory, length, MADV_HUGEPAGE); // advisory: THP may be disabled system-wide
+            return memory;
+        }
+#endif
+    }
+
+    void* allocate(std::size_t bytes) {
+        Registry& shared = registry();
+        recordAllocation(bytes);
+        if (bytes < shared.threshold.load(std::memory_order_relaxed)) {
+            MATRIX_TRY {
+                return ::operator new(bytes);
+            } MATRIX_CATCH_ALL {
+                recordRelease(bytes);
+                MATRIX_RETHROW;
+            }
+        }
+        std::size_t length = roundUp(bytes);
+        void* memory = nullptr;
+        bool hugetlbfs = false;
+        MATRIX_TRY {
+#ifdef __linux__
+            std::string directory = hugetlbfsPath();
+            if (!directory.empty()) {
+                memory = mapHugetlbfs(directory, length);
+                hugetlbfs = memory != nullptr;
+            }
+            if (!memory)
+                memory = mapAnonymous(length);
+#else
+            memory = ::operator new(length, std::align_val_t(HUGE_PAGE_SIZE));
+#endif
+        } MATRIX_CATCH_ALL {
+            recordRelease(bytes);
+            MATRIX_RETHROW;
+        }
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.regions[reinterpret_cast<std::uintptr_t>(memory)] = Region{length, hugetlbfs};
+        return memory;
+    }
+
+    void deallocate(void* pointer, std::size_t bytes) {
+        if (!pointer)
+            return;
+        recordRelease(bytes);
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+        // Large buffers are always 2 MiB-aligned, so most small frees skip the lookup.
+        if (address % HUGE_PAGE_SIZE == 0) {
+            Registry& shared = registry();
+            std::unique_lock<std::mutex> lock(shared.mutex);
+            auto found = shared.regions.find(address);
+            if (found != shared.regions.end()) {
+                std::size_t length = found->second.length;
+                shared.regions.erase(found);
+                lock.unlock();
+#ifdef __linux__
+                munmap(pointer, length);
+#else
+                (void)length;
+                ::operator delete(pointer, std::align_val_t(HUGE_PAGE_SIZE));
+#endif
+                return;
+            }
+        }
+        ::operator delete(pointer);
+    }
+
+    std::size_t hugePageThreshold() {
+        return registry().threshold.load(std::memory_order_relaxed);
+    }
+
+    void setHugePageThreshold(std::size_t bytes) {
+        registry().threshold.store(bytes, std::memory_order_relaxed);
+    }
+
+    void setHugetlbfsPath(const std::string& path) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.hugetlbfs = path;
+    }
+
+    std::string hugetlbfsPath() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        return shared.hugetlbfs;
+    }
+
+    HugePageStats hugePageStats() {
+        HugePageStats stats{0, 0, 0, 0};
+        std::map<std::uintptr_t, Region> regions;
+        {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            regions = shared.regions;
+        }
+        for (const auto& entry : regions) {
+            stats.largeBytes += entry.second.length;
+            if (entry.second.hugetlbfs)
+                stats.hugetlbfsBytes += entry.second.length;
+            ++stats.regions;
+        }
+        stats.hugeBackedBytes = stats.hugetlbfsBytes;
+
+        // smaps lists each mapping as "start-end perms ..." followed by "Key: value kB" lines.
+        // A mapping may span several adjacent buffers (the kernel merges them), so its huge
+        // pages are credited up to the bytes it shares with anonymous large buffers.
+        std::ifstream smaps("/proc/self/smaps");
+        std::string line;
+        std::size_t overlap = 0;
+        while (std::getline(smaps, line)) {
+            std::uintptr_t start = 0, end = 0;
+            char dash = 0;
+            std::istringstream header(line);
+            if (line.find(':') > line.find(' ') && (header >> std::hex >> start >> dash >> end) && dash == '-') {
+                overlap = 0;
+                for (const auto& entry : regions) {
+                    if (entry.second.hugetlbfs)
+                        continue;
+                    std::uintptr_t first = entry.first > start ? entry.first : start;
+                    std::uintptr_t last = entry.first + entry.second.length < end ? entry.first + entry.second.length : end;
+                    if (last > first)
+                        overlap += last - first;
+                }
+                continue;
+            }
+            if (overlap > 0 && line.compare(0, 14, "AnonHugePages:") == 0) {
+                std::size_t kilobytes = std::strtoull(line.c_str() + 14, nullptr, 10);
+                std::size_t huge = kilobytes * 1024;
+                stats.hugeBackedBytes += huge < overlap ? huge : overlap;
+            }
+        }
+        return stats;
+    }
+
+} // namespace MemoryGM
@@ -0,0 +1,69 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Cell-buffer allocator that backs large matrix and vector buffers with huge pages.
+ *
+ * Buffers of at least `hugePageThreshold()` bytes are mapped 2 MiB-aligned and advised
+ * with madvise(MADV_HUGEPAGE), so the kernel can back them with transparent huge pages
+ * and a large matrix costs a few hundred TLB entries instead of millions. When a
+ * hugetlbfs mount is configured (setHugetlbfsPath or MATRIX_HUGETLBFS), large buffers
+ * are mapped from a file there first, falling back to anonymous memory if that fails.
+ * Smaller buffers use the normal allocator.
+ *
+ * A matrix whose cells reach the threshold allocates them as one slab (see
+ * SquareMatrix), so even rows that are individually small share huge pages.
+ */
+
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace MemoryGM {
+
+    const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; ///< Alignment and rounding of large buffers
+
+    /**
+     * @brief Large-buffer statistics of the process.
+     */
+    struct HugePageStats {
+        std::size_t largeBytes;      ///< Bytes mapped for live large buffers (rounded to 2 MiB)
+        std::size_t hugeBackedBytes; ///< Part of largeBytes actually backed by huge pages
+        std::size_t hugetlbfsBytes;  ///< Part of largeBytes mapped from hugetlbfs
+        int regions;                 ///< Number of live large buffers
+    };
+
+    /**
+     * @brief Allocates `bytes` of uninitialized memory; huge-page backed when at or above the threshold.
+     * The bytes are recorded in the memory accounting (MemoryAccounting.hpp).
+     * @throws std::bad_alloc when the memory cannot be obtained.
+     * @throws MemoryBudgetExceeded when the memory budget does not allow it.
+     */
+    void* allocate(std::size_t bytes);
+
+    /**
+     * @brief Frees memory returned by allocate(`bytes`).
+     */
+    void deallocate(void* pointer, std::size_t bytes);
+
+    std::size_t hugePageThreshold(); ///< Smallest buffer, in bytes, that gets huge pages
+    void setHugePageThreshold(std::size_t bytes); ///< Changes the threshold for later allocations
+
+    /**
+     * @brief Directory on a hugetlbfs mount to map large buffers from; empty disables it.
+     *
+     * Defaults to the MATRIX_HUGETLBFS environment variable.
+     */
+    void setHugetlbfsPath(const std::string& path);
+    std::string hugetlbfsPath(); ///< Current hugetlbfs directory, or empty
+
+    /**
+     * @brief Current statistics. Huge-page backing is read from /proc/self/smaps
+     * (AnonHugePages of the large buffers' mappings); it is 0 where that file is missing.
+     */
+    HugePageStats hugePageStats();
+
+} // namespace MemoryGM
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file MemoryAccounting.cpp
+ * @brief Implements the live, peak and budget counters of the accounted memory.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "MemoryAccounting.hpp"
+#include <atomic>
+#include "../Exception/MyExceptions.hpp"
+#include "../Profiling/PerfCounters.hpp"
+
+namespace MemoryGM {
+
+    namespace {
+        std::atomic<std::size_t> live{0};
+        std::atomic<std::size_t> peak{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> releases{0};
+        std::atomic<std::size_t> budget{0};
+
+        void raisePeak(std::size_t bytes) {
+            std::size_t seen = peak.load(std::memory_order_relaxed);
+            while (bytes > seen && !peak.compare_exchange_weak(seen, bytes, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    MemoryStats memoryStats() {
+        return MemoryStats{live.load(std::memory_order_relaxed), peak.load(std::memory_order_relaxed),
+                           allocations.load(std::memory_order_relaxed), releases.load(std::memory_order_relaxed)};
+    }
+
+    void resetPeakBytes() {
+        peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    void setMemoryBudget(std::size_t bytes) {
+        budget.store(bytes, std::memory_order_relaxed);
+    }
+
+    std::size_t memoryBudget() {
+        return budget.load(std::memory_order_relaxed);
+    }
+
+    void recordAllocation(std::size_t bytes) {
+        std::size_t total = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t limit = budget.load(std::memory_order_relaxed);
+        if (limit != 0 && total > limit) {
+            live.fetch_sub(bytes, std::memory_order_relaxed);
+            MATRIX_THROW(MemoryBudgetExceeded());
+        }
+        raisePeak(total);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        ProfilingGM::ScopedOperation::countAllocation(bytes);
+    }
+
+    void recordRelease(std::size_t bytes) {
+        live.fetch_sub(bytes, std::memory_order_relaxed);
+        releases.fetch_add(1, std::memory_order_relaxed);
+        ProfilingGM::ScopedOperation::countRelease(bytes);
+    }
+
+} // namespace MemoryGM
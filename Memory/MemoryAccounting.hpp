@@ -0,0 +1,113 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Process-wide accounting of the memory held by matrices and vectors.
+ *
+ * Every cell buffer (allocate() in HugePages.hpp), matrix row array and shared row
+ * storage, the column copies of transposeColumnsToRows and the determinant's work
+ * array are recorded here, with their real sizes (a cell is larger than its value).
+ * The totals give live and peak bytes; footprint() of a matrix or vector gives its own
+ * share. Each allocation is also charged to the calling thread's innermost operator,
+ * whose peak transient bytes appear in the performance counters (PerfCounters.hpp).
+ *
+ * The scratch arrays of the factorizations, solvers and view kernels go through
+ * allocateArray() or ScratchArray, so they are recorded as well.
+ *
+ * setMemoryBudget() turns the accounting into a limit: an allocation that would take
+ * the live bytes past it throws MemoryBudgetExceeded instead.
+ */
+
+#ifndef MEMORY_ACCOUNTING_HPP
+#define MEMORY_ACCOUNTING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "../Exception/MyExceptions.hpp"
+
+namespace MemoryGM {
+
+    /**
+     * @brief Accounted memory of the process.
+     */
+    struct MemoryStats {
+        std::size_t liveBytes;  ///< Bytes currently allocated
+        std::size_t peakBytes;  ///< Highest liveBytes since start or resetPeakBytes()
+        uint64_t allocations;   ///< Allocations recorded so far
+        uint64_t releases;      ///< Releases recorded so far
+    };
+
+    MemoryStats memoryStats(); ///< Current totals
+    void resetPeakBytes(); ///< Restarts the peak from the current live bytes
+
+    /**
+     * @brief Limits the live bytes; 0 (the default) means unlimited.
+     */
+    void setMemoryBudget(std::size_t bytes);
+    std::size_t memoryBudget(); ///< Current budget, 0 if unlimited
+
+    /**
+     * @brief Records an allocation of `bytes`, before it is made.
+     * @throws MemoryBudgetExceeded if it would exceed the budget; nothing is recorded then.
+     */
+    void recordAllocation(std::size_t bytes);
+
+    /**
+     * @brief Records that `bytes` recorded earlier were freed.
+     */
+    void recordRelease(std::size_t bytes);
+
+    /**
+     * @brief `new T[count]`, recorded.
+     * @throws MemoryBudgetExceeded if the array would exceed the budget.
+     */
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        recordAllocation(sizeof(T) * count);
+        MATRIX_TRY {
+            return new T[count];
+        } MATRIX_CATCH_ALL {
+            recordRelease(sizeof(T) * count);
+            MATRIX_RETHROW;
+        }
+    }
+
+    /**
+     * @brief `delete[] array` for an array of `count` elements from allocateArray().
+     */
+    template <typename T>
+    void releaseArray(T* array, std::size_t count) {
+        if (!array)
+            return;
+        delete[] array;
+        recordRelease(sizeof(T) * count);
+    }
+
+    /**
+     * @brief Scratch array from allocateArray(), released when it goes out of scope,
+     * so a kernel that throws half-way does not leak it. An empty one allocates nothing.
+     * Moving hands the array over, so a helper can fill one and return it.
+     */
+    template <typename T>
+    class ScratchArray {
+    public:
+        explicit ScratchArray(std::size_t count) : array(count ? allocateArray<T>(count) : nullptr), count(count) {}
+        ScratchArray(ScratchArray&& other) noexcept : array(other.array), count(other.count) {
+            other.array = nullptr;
+            other.count = 0;
+        }
+        ~ScratchArray() { releaseArray(array, count); }
+        ScratchArray(const ScratchArray&) = delete;
+        ScratchArray& operator=(const ScratchArray&) = delete;
+        ScratchArray& operator=(ScratchArray&&) = delete;
+
+        T* get() const { return array; }
+        T& operator[](std::size_t index) const { return array[index]; }
+
+    private:
+        T* array;
+        std::size_t count;
+    };
+
+} // namespace MemoryGM
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Execution policies accepted by the policy overloads of the matrix operations.
+ *
+ * The tags mirror the standard library's: `seq` runs on the calling thread, `par`
+ * splits rows across the shared TaskScheduler once there is enough work per task, and
+ * `par_unseq` additionally runs each row through a raw-cell kernel (no per-element
+ * bounds checks or logging) that the compiler is free to vectorize.
+ *
+ * Example: `SquareMatrix c = add(par, a, b); scaleInPlace(par_unseq, c, 0.5);`
+ */
+
+#ifndef EXECUTION_POLICY_HPP
+#define EXECUTION_POLICY_HPP
+
+#include <type_traits>
+
+namespace ParallelGM {
+
+    /**
+     * @brief Runtime form of a policy, used inside the matrix kernels.
+     */
+    enum class Execution {
+        Automatic,          ///< Operators: parallel only for large matrices
+        Sequential,         ///< Calling thread only
+        Parallel,           ///< Rows split across workers
+        ParallelUnsequenced ///< Rows split across workers, vectorizable row kernels
+    };
+
+    struct SequencedPolicy { static constexpr Execution execution = Execution::Sequential; };
+    struct ParallelPolicy { static constexpr Execution execution = Execution::Parallel; };
+    struct ParallelUnsequencedPolicy { static constexpr Execution execution = Execution::ParallelUnsequenced; };
+
+    inline constexpr SequencedPolicy seq{};
+    inline constexpr ParallelPolicy par{};
+    inline constexpr ParallelUnsequencedPolicy par_unseq{};
+
+    /**
+     * @brief True for the three policy tag types.
+     */
+    template <typename Policy>
+    struct IsExecutionPolicy : std::false_type {};
+    template <> struct IsExecutionPolicy<SequencedPolicy> : std::true_type {};
+    template <> struct IsExecutionPolicy<ParallelPolicy> : std::true_type {};
+    template <> struct IsExecutionPolicy<ParallelUnsequencedPolicy> : std::true_type {};
+
+} // namespace ParallelGM
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file NumaTopology.cpp
+ * @brief Implements NUMA topology detection from sysfs.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "NumaTopology.hpp"
+#include <cctype>
+#include <fstream>
+#include <thread>
+#include "../Exception/MyExceptions.hpp"
+
+namespace ParallelGM {
+
+    namespace {
+        bool readLine(const std::string& path, std::string& line) {
+            std::ifstream file(path);
+            return static_cast<bool>(std::getline(file, line));
+        }
+
+        std::vector<std::vector<int>> singleNode(int cpus) {
+            std::vector<int> all;
+            for (int cpu = 0; cpu < (cpus > 0 ? cpus : 1); ++cpu)
+                all.push_back(cpu);
+            return {all};
+        }
+    }
+
+    NumaTopology::NumaTopology(std::vector<std::vector<int>> nodeCpus) : nodeCpus(std::move(nodeCpus)) {
+        if (this->nodeCpus.empty())
+            MATRIX_THROW(InvalidArgument());
+        for (int node = 0; node < nodeCount(); ++node)
+            nodeIds.push_back(node);
+    }
+
+    NumaTopology::NumaTopology(std::vector<int> nodeIds, std::vector<std::vector<int>> nodeCpus)
+        : nodeIds(std::move(nodeIds)), nodeCpus(std::move(nodeCpus)) {
+        if (this->nodeCpus.empty() || this->nodeIds.size() != this->nodeCpus.size())
+            MATRIX_THROW(InvalidArgument());
+        for (size_t i = 0; i < this->nodeIds.size(); ++i) {
+            if (this->nodeIds[i] < 0)
+                MATRIX_THROW(InvalidArgument());
+            for (size_t j = 0; j < i; ++j)
+                if (this->nodeIds[j] == this->nodeIds[i])
+                    MATRIX_THROW(InvalidArgument());
+        }
+    }
+
+    std::vector<int> NumaTopology::parseList(const std::string& list) {
+        std::vector<int> values;
+        if (!tryParseList(list, values))
+            MATRIX_THROW(InvalidArgument());
+        return values;
+    }
+
+    bool NumaTopology::tryParseList(const std::string& list, std::vector<int>& values) {
+        values.clear();
+        size_t pos = 0;
+        auto readNumber = [&](int& value) {
+            if (pos >= list.size() || !std::isdigit(static_cast<unsigned char>(list[pos])))
+                return false;
+            value = 0;
+            while (pos < list.size() && std::isdigit(static_cast<unsigned char>(list[pos])))
+                value = value * 10 + (list[pos++] - '0');
+            return true;
+        };
+        while (pos < list.size() && !std::isspace(static_cast<unsigned char>(list[pos]))) {
+            int first = 0;
+            if (!readNumber(first))
+                return false;
+            int last = first;
+            if (pos < list.size() && list[pos] == '-') {
+                ++pos;
+                if (!readNumber(last) || last < first)
+                    return false;
+            }
+            for (int value = first; value <= last; ++value)
+                values.push_back(value);
+            if (pos < list.size() && list[pos] == ',')
+                ++pos;
+        }
+        return true;
+    }
+
+    NumaTopology NumaTopology::fromSysfs(const std::string& sysNodeDir, int fallbackCpus) {
+        std::string line;
+        if (!readLine(sysNodeDir + "/online", line))
+            return NumaTopology(singleNode(fallbackCpus));
+        std::vector<std::vector<int>> nodes;
+        std::vector<int> online;
+        if (!tryParseList(line, online))
+            return NumaTopology(singleNode(fallbackCpus));
+        for (int node : online) {
+            std::string cpulist;
+            std::vector<int> cpus;
+            if (!readLine(sysNodeDir + "/node" + std::to_string(node) + "/cpulist", cpulist) ||
+                !tryParseList(cpulist, cpus))
+                return NumaTopology(singleNode(fallbackCpus));
+            nodes.push_back(cpus); // memory-only nodes keep an empty CPU list
+        }
+        if (nodes.empty())
+            return NumaTopology(singleNode(fallbackCpus));
+        return NumaTopology(online, nodes);
+    }
+
+    const NumaTopology& NumaTopology::system() {
+        static const NumaTopology topology =
+            fromSysfs("/sys/devices/system/node", static_cast<int>(std::thread::hardware_concurrency()));
+        return topology;
+    }
+
+    int NumaTopology::nodeCount() const {
+        return static_cast<int>(nodeCpus.size());
+    }
+
+    const std::vector<int>& NumaTopology::cpus(int node) const {
+        if (node < 0 || node >= nodeCount())
+            MATRIX_THROW(MyOutOfRange());
+        return nodeCpus[node];
+    }
+
+    int NumaTopology::nodeOfCpu(int cpu) const {
+        for (int node = 0; node < nodeCount(); ++node)
+            for (int id : nodeCpus[node])
+                if (id == cpu)
+                    return node;
+        return 0;
+    }
+
+    int NumaTopology::nodeId(int node) const {
+        if (node < 0 || node >= nodeCount())
+            MATRIX_THROW(MyOutOfRange());
+        return nodeIds[node];
+    }
+
+    int NumaTopology::nodeIndex(int id) const {
+        for (int node = 0; node < nodeCount(); ++node)
+            if (nodeIds[node] == id)
+                return node;
+        MATRIX_THROW(InvalidArgument());
+    }
+
+} // namespace ParallelGM
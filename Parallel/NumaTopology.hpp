@@ -0,0 +1,127 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief NUMA topology detection and per-matrix row placement policies.
+ *
+ * The topology is read from /sys/devices/system/node (the `online` node list and each
+ * node's `cpulist`), so no external NUMA library is needed. Machines without that tree
+ * are treated as one node holding every CPU.
+ *
+ * A NumaPlacement decides on which node each row of a matrix lives. Rows are placed by
+ * first touch: the row is allocated and written by a worker pinned to the target node,
+ * and the matrix's parallel row loops hand each row to a worker of the same node.
+ */
+
+#ifndef NUMA_TOPOLOGY_HPP
+#define NUMA_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+
+namespace ParallelGM {
+
+    /**
+     * @class NumaTopology
+     * @brief CPUs of each NUMA node.
+     *
+     * Nodes are numbered by index 0..nodeCount()-1. The kernel's ids of the online nodes
+     * need not be contiguous (e.g. "0,2"); nodeId() and nodeIndex() convert between them.
+     */
+    class NumaTopology {
+    private:
+        std::vector<int> nodeIds; ///< Kernel id of each node
+        std::vector<std::vector<int>> nodeCpus; ///< CPU ids per node, in node order
+
+    public:
+        /**
+         * @brief Topology from explicit CPU lists, one per node; node i has kernel id i.
+         * @throws InvalidArgument if no node is given.
+         */
+        explicit NumaTopology(std::vector<std::vector<int>> nodeCpus);
+
+        /**
+         * @brief Topology from the kernel ids of the nodes and their CPU lists.
+         * @throws InvalidArgument if no node is given, the lists differ in length, or an id
+         *         is negative or repeated.
+         */
+        NumaTopology(std::vector<int> nodeIds, std::vector<std::vector<int>> nodeCpus);
+
+        /**
+         * @brief Reads the topology below `sysNodeDir` (normally /sys/devices/system/node).
+         *
+         * Falls back to a single node with `fallbackCpus` CPUs when the directory or a
+         * node's cpulist cannot be read.
+         */
+        static NumaTopology fromSysfs(const std::string& sysNodeDir, int fallbackCpus);
+
+        /**
+         * @brief The topology of this machine, detected once.
+         */
+        static const NumaTopology& system();
+
+        /**
+         * @brief Parses a kernel CPU/node list such as "0-3,8,10-11".
+         * @throws InvalidArgument on malformed input.
+         */
+        static std::vector<int> parseList(const std::string& list);
+
+        /**
+         * @brief Non-throwing parseList: fills `values` and returns false on malformed input.
+         */
+        static bool tryParseList(const std::string& list, std::vector<int>& values);
+
+        int nodeCount() const; ///< Number of nodes (at least 1)
+        const std::vector<int>& cpus(int node) const; ///< CPU ids of `node`
+        int nodeOfCpu(int cpu) const; ///< Node containing `cpu`, or 0 if unknown
+        int nodeId(int node) const; ///< Kernel id of `node`; @throws MyOutOfRange
+        int nodeIndex(int id) const; ///< Node whose kernel id is `id`; @throws InvalidArgument if it is not online
+    };
+
+    /**
+     * @brief Per-matrix policy deciding the NUMA node of every row.
+     */
+    struct NumaPlacement {
+        enum class Kind {
+            Default,    ///< Wherever the allocating thread runs; loops are not node-aware
+            FirstTouch, ///< Contiguous row blocks, one per node, matching the parallel row partition
+            Interleave, ///< Row i on node i % nodes
+            Bind        ///< Every row on one node
+        };
+
+        Kind kind;
+        int node; ///< Kernel id of the target node for Bind, as listed in /sys/devices/system/node/online
+
+        static NumaPlacement byDefault() { return {Kind::Default, 0}; }
+        static NumaPlacement firstTouch() { return {Kind::FirstTouch, 0}; }
+        static NumaPlacement interleave() { return {Kind::Interleave, 0}; }
+        static NumaPlacement bind(int node) { return {Kind::Bind, node}; }
+
+        bool isPlaced() const { return kind != Kind::Default; } ///< True when rows are node-bound
+
+        /**
+         * @brief Node (index) of `row` in a matrix of `rows` rows on `topology`.
+         * @throws InvalidArgument if this binds to a node that `topology` does not have.
+         */
+        int nodeOfRow(int row, int rows, const NumaTopology& topology) const {
+            int nodes = topology.nodeCount();
+            switch (kind) {
+                case Kind::FirstTouch:
+                    return static_cast<int>(static_cast<long long>(row) * nodes / rows);
+                case Kind::Interleave:
+                    return row % nodes;
+                case Kind::Bind:
+                    return topology.nodeIndex(node);
+                default:
+                    return 0;
+            }
+        }
+
+        bool operator==(const NumaPlacement& other) const {
+            return kind == other.kind && (kind != Kind::Bind || node == other.node);
+        }
+        bool operator!=(const NumaPlacement& other) const { return !(*this == other); }
+    };
+
+} // namespace ParallelGM
+
+#endif
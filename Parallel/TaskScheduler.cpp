@@ -0,0 +1,392 @@
+/**
+ * @file TaskScheduler.cpp
+ * @brief Implements the Chase-Lev deque, the worker pool and fork/join groups.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "TaskScheduler.hpp"
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "../Exception/MyExceptions.hpp"
+#include "../Profiling/Trace.hpp"
+
+namespace ParallelGM {
+
+    namespace {
+        thread_local const TaskScheduler* currentScheduler = nullptr; ///< Scheduler owning the calling thread
+        thread_local int currentIndex = -1;                           ///< Worker index within that scheduler
+        thread_local uint32_t victimSeed = 0x9e3779b9u;               ///< xorshift state for victim selection
+
+        uint32_t nextRandom() {
+            victimSeed ^= victimSeed << 13;
+            victimSeed ^= victimSeed >> 17;
+            victimSeed ^= victimSeed << 5;
+            return victimSeed;
+        }
+    }
+
+    // === WorkStealingDeque ===
+
+    WorkStealingDeque::Buffer::Buffer(int64_t capacity)
+        : capacity(capacity), slots(new std::atomic<Task*>[capacity]), retired(nullptr) {}
+
+    WorkStealingDeque::Buffer::~Buffer() {
+        delete[] slots;
+        delete retired;
+    }
+
+    Task* WorkStealingDeque::Buffer::get(int64_t index) const {
+        return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void WorkStealingDeque::Buffer::put(int64_t index, Task* task) {
+        slots[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque::WorkStealingDeque(int64_t capacity)
+        : top(0), bottom(0), buffer(new Buffer(capacity)) {}
+
+    WorkStealingDeque::~WorkStealingDeque() {
+        delete buffer.load(std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque::Buffer* WorkStealingDeque::grow(Buffer* old, int64_t bottomIndex, int64_t topIndex) {
+        Buffer* bigger = new Buffer(old->capacity * 2);
+        for (int64_t i = topIndex; i < bottomIndex; ++i)
+            bigger->put(i, old->get(i));
+        bigger->retired = old;
+        buffer.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    void WorkStealingDeque::push(Task* task) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1)
+            a = grow(a, b, t);
+        a->put(b, task);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    Task* WorkStealingDeque::pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = a->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task* WorkStealingDeque::steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        Task* task = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return task;
+    }
+
+    // === TaskScheduler ===
+
+    TaskScheduler::TaskScheduler(int workers, const NumaTopology& topology, bool pin)
+        : workers(workers), topology(topology), pinned(pin), nextMailbox(0), sleeping(0), submitted(0), stopping(false) {
+        if (workers < 0)
+            MATRIX_THROW(InvalidArgument());
+        std::vector<int> nodesWithCpus;
+        for (int node = 0; node < topology.nodeCount(); ++node) {
+            if (!topology.cpus(node).empty())
+                nodesWithCpus.push_back(node);
+        }
+        if (nodesWithCpus.empty())
+            nodesWithCpus.push_back(0);
+        int groups = static_cast<int>(nodesWithCpus.size());
+        for (int i = 0; i < workers; ++i) {
+            deques.push_back(new WorkStealingDeque());
+            mailboxes.push_back(new Mailbox());
+            workerNodes.push_back(nodesWithCpus[static_cast<long long>(i) * groups / workers]);
+        }
+        threads.reserve(workers);
+        for (int i = 0; i < workers; ++i)
+            threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping.store(true);
+        }
+        wakeup.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+        for (WorkStealingDeque* deque : deques)
+            delete deque;
+        for (Mailbox* mailbox : mailboxes)
+            delete mailbox;
+    }
+
+    TaskScheduler& TaskScheduler::instance() {
+        static TaskScheduler scheduler([] {
+            if (const char* env = std::getenv("MATRIX_NUM_THREADS")) {
+                int requested = std::atoi(env);
+                return requested > 0 ? requested - 1 : 0;
+            }
+            int hardware = static_cast<int>(std::thread::hardware_concurrency());
+            return hardware > 1 ? hardware - 1 : 0;
+        }(), NumaTopology::system(), [] {
+            const char* env = std::getenv("MATRIX_PIN_WORKERS");
+            if (env && std::strcmp(env, "0") == 0)
+                return false;
+            return NumaTopology::system().nodeCount() > 1;
+        }());
+        return scheduler;
+    }
+
+    int TaskScheduler::workerCount() const {
+        return workers;
+    }
+
+    int TaskScheduler::nodeCount() const {
+        return topology.nodeCount();
+    }
+
+    const NumaTopology& TaskScheduler::numaTopology() const {
+        return topology;
+    }
+
+    int TaskScheduler::nodeOfWorker(int worker) const {
+        if (worker < 0 || worker >= workers)
+            MATRIX_THROW(MyOutOfRange());
+        return workerNodes[worker];
+    }
+
+    int TaskScheduler::workersOnNode(int node) const {
+        int count = 0;
+        for (int workerNode : workerNodes)
+            if (workerNode == node)
+                ++count;
+        return count;
+    }
+
+    int TaskScheduler::currentNode() const {
+        int self = currentWorker();
+        return self >= 0 ? workerNodes[self] : -1;
+    }
+
+    bool TaskScheduler::isPinned() const {
+        return pinned;
+    }
+
+    int TaskScheduler::autoGrain(int count) const {
+        int pieces = 4 * (workerCount() + 1);
+        int grain = count / pieces;
+        return grain > 0 ? grain : 1;
+    }
+
+    int TaskScheduler::currentWorker() const {
+        return currentScheduler == this ? currentIndex : -1;
+    }
+
+    void TaskScheduler::submit(Task* task) {
+        int self = currentWorker();
+        if (self >= 0) {
+            deques[self]->push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(injectedMutex);
+            injected.push_back(task);
+        }
+        wakeWorkers(false);
+    }
+
+    void TaskScheduler::submitToNode(Task* task, int node) {
+        int count = workersOnNode(node);
+        if (count == 0) {
+            submit(task);
+            return;
+        }
+        int pick = static_cast<int>(nextMailbox.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned>(count));
+        for (int worker = 0; worker < workers; ++worker) {
+            if (workerNodes[worker] != node || pick-- > 0)
+                continue;
+            {
+                std::lock_guard<std::mutex> lock(mailboxes[worker]->mutex);
+                mailboxes[worker]->tasks.push_back(task);
+            }
+            // Only the addressed worker can take it, so wake every sleeper.
+            wakeWorkers(true);
+            return;
+        }
+    }
+
+    void TaskScheduler::wakeWorkers(bool all) {
+        // Pairs with workerLoop: either the sleeper's epoch check sees this bump, or this load sees the sleeper.
+        submitted.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_seq_cst) == 0)
+            return;
+        // A sleeper holds sleepMutex from its epoch check until it waits, so the notification cannot fall in between.
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        if (all)
+            wakeup.notify_all();
+        else
+            wakeup.notify_one();
+    }
+
+    Task* TaskScheduler::takeMail(int worker) {
+        Mailbox* mailbox = mailboxes[worker];
+        std::lock_guard<std::mutex> lock(mailbox->mutex);
+        if (mailbox->tasks.empty())
+            return nullptr;
+        Task* task = mailbox->tasks.front();
+        mailbox->tasks.pop_front();
+        return task;
+    }
+
+    Task* TaskScheduler::findWork() {
+        int self = currentWorker();
+        if (self >= 0) {
+            if (Task* task = takeMail(self))
+                return task;
+            if (Task* task = deques[self]->pop())
+                return task;
+        }
+        int count = workerCount();
+        if (count > 0) {
+            int start = static_cast<int>(nextRandom() % static_cast<uint32_t>(count));
+            for (int k = 0; k < count; ++k) {
+                int victim = (start + k) % count;
+                if (victim == self) continue;
+                if (Task* task = deques[victim]->steal())
+                    return task;
+            }
+        }
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        if (injected.empty())
+            return nullptr;
+        Task* task = injected.front();
+        injected.pop_front();
+        return task;
+    }
+
+    void TaskScheduler::execute(Task* task) {
+        TaskGroup* group = task->group;
+        {
+            TRACE_SPAN("task", ProfilingGM::SpanKind::Task);
+            MATRIX_TRY {
+                task->func();
+            } MATRIX_CATCH_ALL {
+                group->fail(std::current_exception());
+            }
+        }
+        delete task;
+        group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void TaskScheduler::workerLoop(int index) {
+        currentScheduler = this;
+        currentIndex = index;
+        ProfilingGM::setThreadName("worker " + std::to_string(index));
+#ifdef __linux__
+        if (pinned && !topology.cpus(workerNodes[index]).empty()) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (int cpu : topology.cpus(workerNodes[index]))
+                if (cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &cpus);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus); // best effort: keep running unpinned on failure
+        }
+#endif
+        victimSeed ^= static_cast<uint32_t>(index + 1) * 0x85ebca6bu;
+        int idleRounds = 0;
+        while (!stopping.load(std::memory_order_acquire)) {
+            uint64_t seen = submitted.load(std::memory_order_seq_cst); // read before searching, so no submission is missed
+            if (Task* task = findWork()) {
+                execute(task);
+                idleRounds = 0;
+                continue;
+            }
+            if (++idleRounds < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Sleep until something is submitted after `seen` or the scheduler stops.
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            wakeup.wait(lock, [&] {
+                return stopping.load(std::memory_order_acquire) || submitted.load(std::memory_order_seq_cst) != seen;
+            });
+            sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            idleRounds = 0;
+        }
+    }
+
+    // === TaskGroup ===
+
+    TaskGroup::TaskGroup(TaskScheduler& scheduler) : scheduler(scheduler), pending(0) {}
+
+    TaskGroup::~TaskGroup() {
+        MATRIX_TRY {
+            wait();
+        } MATRIX_CATCH_ALL {
+            // Destructors must not throw; the exception was already reported by wait() if it was called.
+        }
+    }
+
+    void TaskGroup::run(std::function<void()> func) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        scheduler.submit(new Task{std::move(func), this});
+    }
+
+    void TaskGroup::runOnNode(int node, std::function<void()> func) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        scheduler.submitToNode(new Task{std::move(func), this}, node);
+    }
+
+    void TaskGroup::wait() {
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (Task* task = scheduler.findWork())
+                scheduler.execute(task);
+            else
+                std::this_thread::yield();
+        }
+        std::exception_ptr thrown;
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            thrown = error;
+            error = nullptr;
+        }
+        if (thrown)
+            std::rethrow_exception(thrown);
+    }
+
+    void TaskGroup::fail(std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+            error = exception;
+    }
+
+    TaskScheduler& TaskGroup::getScheduler() const {
+        return scheduler;
+    }
+
+} // namespace ParallelGM
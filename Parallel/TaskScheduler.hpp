@@ -0,0 +1,319 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Work-stealing task scheduler shared by every parallel matrix operation.
+ *
+ * Each worker thread owns a Chase-Lev deque: it pushes and pops tasks at the bottom
+ * (LIFO, cache-warm), while idle workers steal from the top (FIFO, the largest
+ * remaining pieces of work). Tasks submitted from outside the pool go through a
+ * small injection queue.
+ *
+ * Fork/join is expressed with TaskGroup: `run` forks a task, `wait` joins. A waiting
+ * thread does not block; it keeps executing queued tasks until its group is done, so
+ * a parallel operation nested inside another (a parallel operator^ calling a parallel
+ * operator*) reuses the same workers instead of oversubscribing the machine.
+ * The first exception thrown by a task of a group is rethrown by `wait`.
+ *
+ * parallelFor splits an index range recursively in halves down to a grain size that
+ * is chosen from the number of workers when none is given.
+ *
+ * Workers are spread over the NUMA nodes and, on multi-node machines, pinned to their
+ * node's CPUs. Tasks forked with `runOnNode` go to a per-worker mailbox that is never
+ * stolen from, so they are guaranteed to run on that node; parallelForNodes uses this
+ * to keep each matrix row on the node that owns its memory.
+ */
+
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "NumaTopology.hpp"
+#include "../Exception/MyExceptions.hpp"
+
+namespace ParallelGM {
+
+    class TaskGroup;
+
+    /**
+     * @brief A unit of work forked by a TaskGroup.
+     */
+    struct Task {
+        std::function<void()> func; ///< Work to run
+        TaskGroup* group;           ///< Group notified on completion
+    };
+
+    /**
+     * @class WorkStealingDeque
+     * @brief Chase-Lev lock-free deque: the owner pushes/pops at the bottom, thieves steal from the top.
+     *
+     * Follows the C11 formulation of Le, Pop, Cohen and Zappa Nardelli. The ring buffer
+     * grows by doubling; retired buffers are kept until the deque is destroyed because a
+     * concurrent thief may still be reading them.
+     */
+    class WorkStealingDeque {
+    private:
+        struct Buffer {
+            int64_t capacity;            ///< Power of two
+            std::atomic<Task*>* slots;   ///< Ring of task pointers
+            Buffer* retired;             ///< Previously used (smaller) buffer
+
+            explicit Buffer(int64_t capacity);
+            ~Buffer();
+            Task* get(int64_t index) const;
+            void put(int64_t index, Task* task);
+        };
+
+        std::atomic<int64_t> top;     ///< Next index to steal
+        std::atomic<int64_t> bottom;  ///< Next index to push
+        std::atomic<Buffer*> buffer;  ///< Current ring buffer
+
+        Buffer* grow(Buffer* old, int64_t bottomIndex, int64_t topIndex);
+
+    public:
+        explicit WorkStealingDeque(int64_t capacity = 256);
+        ~WorkStealingDeque();
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        void push(Task* task); ///< Owner only
+        Task* pop();           ///< Owner only; nullptr when empty
+        Task* steal();         ///< Any thread; nullptr when empty or when losing a race
+    };
+
+    /**
+     * @class TaskScheduler
+     * @brief Pool of worker threads with one work-stealing deque each.
+     */
+    class TaskScheduler {
+    private:
+        /**
+         * @brief Tasks addressed to one worker; only that worker takes them.
+         */
+        struct Mailbox {
+            std::mutex mutex;
+            std::deque<Task*> tasks;
+        };
+
+        const int workers;                      ///< Fixed before any thread starts
+        std::vector<std::thread> threads;
+        std::vector<WorkStealingDeque*> deques; ///< One per worker
+        std::vector<Mailbox*> mailboxes;        ///< One per worker
+        std::vector<int> workerNodes;           ///< NUMA node of each worker
+        const NumaTopology topology;            ///< Nodes and their CPUs, for pinning and node ids
+        bool pinned;                            ///< Workers are bound to their node's CPUs
+        std::atomic<unsigned> nextMailbox;      ///< Round-robin among a node's workers
+        std::deque<Task*> injected;             ///< Tasks submitted by non-worker threads
+        std::mutex injectedMutex;
+        std::mutex sleepMutex;
+        std::condition_variable wakeup;
+        std::atomic<int> sleeping;
+        std::atomic<uint64_t> submitted;        ///< Bumped by every submission; sleepers wait for it to change
+        std::atomic<bool> stopping;
+
+        void workerLoop(int index);
+        Task* findWork(); ///< Own deque, then a random victim, then the injection queue
+        int currentWorker() const; ///< Index of the calling worker of this scheduler, or -1
+
+        friend class TaskGroup;
+        void submit(Task* task);
+        void submitToNode(Task* task, int node);
+        void execute(Task* task);
+        Task* takeMail(int worker);
+        void wakeWorkers(bool all); ///< Publishes a submission and wakes sleepers
+
+    public:
+        /**
+         * @brief Starts `workers` threads. With zero workers every task runs on the thread that waits for it.
+         *
+         * Workers are assigned to the nodes of `topology` that have CPUs, in contiguous
+         * groups, and bound to their node's CPUs when `pin` is set.
+         * @throws InvalidArgument if workers is negative.
+         */
+        explicit TaskScheduler(int workers, const NumaTopology& topology = NumaTopology::system(), bool pin = false);
+
+        /**
+         * @brief Stops and joins the workers. Outstanding groups must have been waited for.
+         */
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /**
+         * @brief The process-wide scheduler used by the matrix operations.
+         *
+         * MATRIX_NUM_THREADS, if set, is the total number of threads including the caller;
+         * otherwise there is one worker per hardware thread besides the caller. Workers are
+         * pinned when the machine has more than one NUMA node, unless MATRIX_PIN_WORKERS=0.
+         */
+        static TaskScheduler& instance();
+
+        int workerCount() const; ///< Number of worker threads (the waiting thread helps as well)
+        int nodeCount() const; ///< Number of NUMA nodes of the topology
+        const NumaTopology& numaTopology() const; ///< The topology the workers were spread over
+        int nodeOfWorker(int worker) const; ///< NUMA node worker `worker` runs on
+        int workersOnNode(int node) const; ///< Number of workers assigned to `node`
+        int currentNode() const; ///< Node of the calling worker of this scheduler, or -1
+        bool isPinned() const; ///< Workers are bound to their node's CPUs
+
+        /**
+         * @brief Grain for splitting `count` iterations: about four pieces per thread.
+         */
+        int autoGrain(int count) const;
+    };
+
+    /**
+     * @class TaskGroup
+     * @brief Fork/join scope: tasks forked with run() are joined by wait().
+     */
+    class TaskGroup {
+    private:
+        TaskScheduler& scheduler;
+        std::atomic<int> pending;     ///< Forked tasks not yet finished
+        std::exception_ptr error;     ///< First exception thrown by a task
+        std::mutex errorMutex;
+
+        friend class TaskScheduler;
+
+    public:
+        explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance());
+
+        /**
+         * @brief Joins outstanding tasks (without rethrowing) if wait() was not called.
+         */
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /**
+         * @brief Forks `func` as a task that any worker may run or steal.
+         */
+        void run(std::function<void()> func);
+
+        /**
+         * @brief Forks `func` as a task that only workers of NUMA node `node` may run.
+         *
+         * Falls back to run() when the node has no workers.
+         */
+        void runOnNode(int node, std::function<void()> func);
+
+        /**
+         * @brief Runs queued tasks until every task of this group has finished.
+         * @throws The first exception thrown by one of the group's tasks.
+         */
+        void wait();
+
+        /**
+         * @brief Records an exception to be rethrown by wait(); later ones are dropped.
+         */
+        void fail(std::exception_ptr exception);
+
+        TaskScheduler& getScheduler() const; ///< Scheduler the tasks are submitted to
+    };
+
+    namespace detail {
+        template <typename Func>
+        void splitRange(TaskGroup& group, int begin, int end, int grain, const Func& func) {
+            while (end - begin > grain) {
+                int middle = begin + (end - begin) / 2;
+                int last = end;
+                group.run([&group, middle, last, grain, &func] {
+                    splitRange(group, middle, last, grain, func);
+                });
+                end = middle;
+            }
+            for (int i = begin; i < end; ++i)
+                func(i);
+        }
+    }
+
+    /**
+     * @brief Calls func(i) for every i in [begin, end), in parallel on `scheduler`.
+     *
+     * The range is split in halves until pieces are at most `grain` iterations long
+     * (`grain` <= 0 picks one with TaskScheduler::autoGrain). Small ranges and
+     * schedulers without workers run inline.
+     * @throws The first exception thrown by func, after all iterations have stopped.
+     */
+    template <typename Func>
+    void parallelFor(TaskScheduler& scheduler, int begin, int end, int grain, const Func& func) {
+        if (end <= begin)
+            return;
+        if (grain <= 0)
+            grain = scheduler.autoGrain(end - begin);
+        if (end - begin <= grain || scheduler.workerCount() == 0) {
+            for (int i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+        TaskGroup group(scheduler);
+        MATRIX_TRY {
+            detail::splitRange(group, begin, end, grain, func);
+        } MATRIX_CATCH_ALL {
+            group.fail(std::current_exception());
+        }
+        group.wait();
+    }
+
+    /**
+     * @brief Calls func(i) for every i in [begin, end), each on a worker of node nodeOf(i).
+     *
+     * The indices of every node are split into one contiguous piece per worker of that
+     * node and sent to those workers' mailboxes, so the static row-to-node partition of
+     * a NUMA-placed matrix is also the partition of the work.
+     * @throws The first exception thrown by func, after all iterations have stopped.
+     */
+    template <typename NodeOf, typename Func>
+    void parallelForNodes(TaskScheduler& scheduler, int begin, int end, const NodeOf& nodeOf, const Func& func) {
+        if (end <= begin)
+            return;
+        if (scheduler.workerCount() == 0 || end - begin == 1) {
+            for (int i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+        int nodes = scheduler.nodeCount();
+        std::vector<std::vector<int>> indices(nodes);
+        for (int i = begin; i < end; ++i) {
+            int node = nodeOf(i);
+            indices[node >= 0 && node < nodes ? node : 0].push_back(i);
+        }
+        TaskGroup group(scheduler);
+        for (int node = 0; node < nodes; ++node) {
+            const std::vector<int>& mine = indices[node];
+            int count = static_cast<int>(mine.size());
+            int pieces = scheduler.workersOnNode(node);
+            if (pieces < 1) pieces = 1;
+            if (pieces > count) pieces = count;
+            for (int piece = 0; piece < pieces; ++piece) {
+                int first = static_cast<int>(static_cast<long long>(count) * piece / pieces);
+                int last = static_cast<int>(static_cast<long long>(count) * (piece + 1) / pieces);
+                group.runOnNode(node, [&mine, first, last, &func] {
+                    for (int k = first; k < last; ++k)
+                        func(mine[k]);
+                });
+            }
+        }
+        group.wait();
+    }
+
+    /**
+     * @brief parallelFor on the process-wide scheduler.
+     */
+    template <typename Func>
+    void parallelFor(int begin, int end, int grain, const Func& func) {
+        parallelFor(TaskScheduler::instance(), begin, end, grain, func);
+    }
+
+} // namespace ParallelGM
+
+#endif
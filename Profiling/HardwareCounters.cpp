@@ -0,0 +1,352 @@
+/**
+ * @file HardwareCounters.cpp
+ * @brief Implements the per-thread perf_event_open groups and their fallbacks.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "HardwareCounters.hpp"
+#include <atomic>
+#include <mutex>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace ProfilingGM {
+
+    namespace {
+        const int VALUE_COUNT = MAX_HARDWARE_COUNTERS + 1; ///< Calls, then one slot per counter
+
+        struct EventSpec {
+            uint32_t type;
+            uint64_t config;
+            const char* name;
+        };
+
+        /// Counter totals and open descriptors of one thread. Only the owner writes the
+        /// totals and touches the descriptors; snapshots read the totals concurrently.
+        struct ThreadHardware {
+            std::atomic<uint64_t> values[OPERATION_COUNT][VALUE_COUNT];
+            int fds[MAX_HARDWARE_COUNTERS];
+            int count = 0;                ///< Open descriptors; the first is the group leader
+            unsigned generation = 0;      ///< Configuration the descriptors were opened for
+            bool usable = false;          ///< This thread could open the configured events
+
+            ThreadHardware() {
+                for (int& fd : fds)
+                    fd = -1;
+                for (auto& operation : values)
+                    for (auto& value : operation)
+                        value.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadHardware*> live;
+            uint64_t retired[OPERATION_COUNT][VALUE_COUNT] = {}; ///< Totals of exited threads
+            std::vector<EventSpec> events;                      ///< Counters of the current source
+            std::atomic<int> source{static_cast<int>(CounterSource::None)};
+            std::atomic<unsigned> generation{1};                ///< Bumped on every enable
+        };
+
+        /// Never destroyed: threads may exit after static destruction has begun.
+        Registry& registry() {
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+
+        void closeAll(ThreadHardware& thread) {
+#ifdef __linux__
+            for (int& fd : thread.fds)
+                if (fd >= 0) {
+                    close(fd);
+                    fd = -1;
+                }
+#endif
+            thread.count = 0;
+            thread.usable = false;
+        }
+
+        /// Registers the thread's totals on first use, folds them into `retired` at exit.
+        struct ThreadSlot {
+            ThreadHardware hardware;
+
+            ThreadSlot() {
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.live.push_back(&hardware);
+            }
+
+            ~ThreadSlot() {
+                closeAll(hardware);
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                for (int op = 0; op < OPERATION_COUNT; ++op)
+                    for (int i = 0; i < VALUE_COUNT; ++i)
+                        shared.retired[op][i] += hardware.values[op][i].load(std::memory_order_relaxed);
+                for (size_t i = 0; i < shared.live.size(); ++i)
+                    if (shared.live[i] == &hardware) {
+                        shared.live[i] = shared.live.back();
+                        shared.live.pop_back();
+                        break;
+                    }
+            }
+        };
+
+        thread_local ThreadSlot slot;
+
+        void add(std::atomic<uint64_t>& counter, uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+#ifdef __linux__
+        std::vector<EventSpec> eventsOf(CounterSource source) {
+            const uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            switch (source) {
+                case CounterSource::Hardware:
+                    return {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+                            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+                            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | readMiss, "l1d_misses"},
+                            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "llc_misses"},
+                            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | readMiss, "dtlb_misses"},
+                            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses"}};
+                case CounterSource::Software:
+                    return {{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, "task_clock_ns"},
+                            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, "page_faults"},
+                            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, "context_switches"},
+                            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, "cpu_migrations"}};
+                case CounterSource::Rusage:
+                    return {{0, 0, "cpu_time_ns"}, {0, 0, "minor_faults"},
+                            {0, 0, "major_faults"}, {0, 0, "context_switches"}};
+                default:
+                    return {};
+            }
+        }
+
+        /// Opens one user-space counter of the calling thread; -1 on failure.
+        int openEvent(const EventSpec& spec, int leader) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = spec.type;
+            attr.config = spec.config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            long fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC);
+            return static_cast<int>(fd);
+        }
+
+        /// Opens `events` as one group on the calling thread. With `keepAvailable`, events
+        /// that fail are removed from the list; otherwise any failure fails the whole group.
+        bool openGroup(std::vector<EventSpec>& events, ThreadHardware& thread, bool keepAvailable) {
+            closeAll(thread);
+            std::vector<EventSpec> opened;
+            for (const EventSpec& spec : events) {
+                int fd = openEvent(spec, thread.count > 0 ? thread.fds[0] : -1);
+                if (fd < 0) {
+                    if (keepAvailable)
+                        continue;
+                    closeAll(thread);
+                    return false;
+                }
+                thread.fds[thread.count++] = fd;
+                opened.push_back(spec);
+            }
+            if (keepAvailable)
+                events = opened;
+            thread.usable = thread.count > 0;
+            return thread.usable;
+        }
+
+        /// Fills `sample` with the counters, then time enabled and time running.
+        bool readSample(ThreadHardware& thread, CounterSource source, uint64_t* sample) {
+            if (source == CounterSource::Rusage) {
+                timespec cpu;
+                rusage usage;
+                if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) != 0 || getrusage(RUSAGE_THREAD, &usage) != 0)
+                    return false;
+                sample[0] = static_cast<uint64_t>(cpu.tv_sec) * 1000000000u + static_cast<uint64_t>(cpu.tv_nsec);
+                sample[1] = static_cast<uint64_t>(usage.ru_minflt);
+                sample[2] = static_cast<uint64_t>(usage.ru_majflt);
+                sample[3] = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+                sample[MAX_HARDWARE_COUNTERS] = sample[MAX_HARDWARE_COUNTERS + 1] = 0;
+                return true;
+            }
+            // PERF_FORMAT_GROUP layout: nr, time enabled, time running, one value per event.
+            uint64_t buffer[3 + MAX_HARDWARE_COUNTERS];
+            ssize_t expected = static_cast<ssize_t>((3 + thread.count) * sizeof(uint64_t));
+            if (read(thread.fds[0], buffer, sizeof(buffer)) != expected)
+                return false;
+            for (int i = 0; i < thread.count; ++i)
+                sample[i] = buffer[3 + i];
+            sample[MAX_HARDWARE_COUNTERS] = buffer[1];
+            sample[MAX_HARDWARE_COUNTERS + 1] = buffer[2];
+            return true;
+        }
+#endif
+
+        /// The calling thread's counters, reopened if the configuration changed; nullptr if unusable.
+        ThreadHardware* prepare(CounterSource source) {
+#ifdef __linux__
+            ThreadHardware& thread = slot.hardware;
+            Registry& shared = registry();
+            unsigned generation = shared.generation.load(std::memory_order_acquire);
+            if (thread.generation != generation) {
+                std::vector<EventSpec> events;
+                {
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    events = shared.events;
+                }
+                thread.generation = generation;
+                if (source == CounterSource::Rusage) {
+                    closeAll(thread);
+                    thread.count = static_cast<int>(events.size());
+                    thread.usable = true;
+                } else {
+                    openGroup(events, thread, false);
+                }
+            }
+            return thread.usable ? &thread : nullptr;
+#else
+            (void)source;
+            return nullptr;
+#endif
+        }
+
+        void zeroTotals(Registry& shared) {
+            for (auto& operation : shared.retired)
+                for (auto& value : operation)
+                    value = 0;
+            for (ThreadHardware* thread : shared.live)
+                for (auto& operation : thread->values)
+                    for (auto& value : operation)
+                        value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    HardwareScope::HardwareScope(Operation operation) : operation(operation), start(), generation(0), active(false) {
+#ifdef __linux__
+        CounterSource source = static_cast<CounterSource>(registry().source.load(std::memory_order_relaxed));
+        if (source == CounterSource::None)
+            return;
+        ThreadHardware* thread = prepare(source);
+        generation = slot.hardware.generation;
+        active = thread && readSample(*thread, source, start);
+#endif
+    }
+
+    HardwareScope::~HardwareScope() {
+#ifdef __linux__
+        if (!active)
+            return;
+        // Skip the sample if counters were disabled or reconfigured since construction.
+        Registry& shared = registry();
+        CounterSource source = static_cast<CounterSource>(shared.source.load(std::memory_order_relaxed));
+        ThreadHardware& thread = slot.hardware;
+        if (source == CounterSource::None || generation != shared.generation.load(std::memory_order_acquire) ||
+            generation != thread.generation || !thread.usable)
+            return;
+        uint64_t end[MAX_HARDWARE_COUNTERS + 2];
+        if (!readSample(thread, source, end))
+            return;
+        // When the kernel multiplexed the group, extrapolate from the time it was counting.
+        uint64_t enabledTime = end[MAX_HARDWARE_COUNTERS] - start[MAX_HARDWARE_COUNTERS];
+        uint64_t runningTime = end[MAX_HARDWARE_COUNTERS + 1] - start[MAX_HARDWARE_COUNTERS + 1];
+        if (source != CounterSource::Rusage && runningTime == 0)
+            return;
+        double scale = runningTime > 0 && runningTime < enabledTime
+            ? static_cast<double>(enabledTime) / static_cast<double>(runningTime) : 1.0;
+        std::atomic<uint64_t>* values = thread.values[static_cast<int>(operation)];
+        add(values[0], 1);
+        for (int i = 0; i < thread.count; ++i)
+            add(values[1 + i], static_cast<uint64_t>(static_cast<double>(end[i] - start[i]) * scale));
+#endif
+    }
+
+    CounterSource enableHardwareCounters(CounterSource preferred) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        CounterSource chosen = CounterSource::None;
+        std::vector<EventSpec> events;
+#ifdef __linux__
+        const CounterSource order[] = {CounterSource::Hardware, CounterSource::Software, CounterSource::Rusage};
+        for (CounterSource candidate : order) {
+            if (candidate < preferred)
+                continue;
+            events = eventsOf(candidate);
+            if (candidate == CounterSource::Rusage) {
+                chosen = candidate;
+                break;
+            }
+            // Probe on this thread; each thread opens its own group on first use.
+            ThreadHardware probe;
+            bool opened = openGroup(events, probe, true);
+            closeAll(probe);
+            if (opened) {
+                chosen = candidate;
+                break;
+            }
+        }
+#else
+        (void)preferred;
+#endif
+        shared.events = chosen == CounterSource::None ? std::vector<EventSpec>() : events;
+        zeroTotals(shared);
+        shared.generation.fetch_add(1, std::memory_order_release);
+        shared.source.store(static_cast<int>(chosen), std::memory_order_relaxed);
+        return chosen;
+    }
+
+    void disableHardwareCounters() {
+        registry().source.store(static_cast<int>(CounterSource::None), std::memory_order_relaxed);
+    }
+
+    CounterSource counterSource() {
+        return static_cast<CounterSource>(registry().source.load(std::memory_order_relaxed));
+    }
+
+    std::vector<std::string> counterNames() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        std::vector<std::string> names;
+        for (const EventSpec& spec : shared.events)
+            names.push_back(spec.name);
+        return names;
+    }
+
+    std::vector<HardwareStats> hardwareSnapshot() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        size_t count = shared.events.size();
+        std::vector<HardwareStats> result;
+        result.reserve(OPERATION_COUNT);
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            uint64_t totals[VALUE_COUNT];
+            for (int i = 0; i < VALUE_COUNT; ++i)
+                totals[i] = shared.retired[op][i];
+            for (const ThreadHardware* thread : shared.live)
+                for (int i = 0; i < VALUE_COUNT; ++i)
+                    totals[i] += thread->values[op][i].load(std::memory_order_relaxed);
+            result.push_back(HardwareStats{static_cast<Operation>(op), totals[0],
+                                           std::vector<uint64_t>(totals + 1, totals + 1 + count)});
+        }
+        return result;
+    }
+
+    HardwareStats hardwareStats(Operation operation) {
+        return hardwareSnapshot()[static_cast<int>(operation)];
+    }
+
+    void resetHardwareCounters() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        zeroTotals(shared);
+    }
+
+} // namespace ProfilingGM
@@ -0,0 +1,88 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Optional hardware performance counters attributed to each operator invocation.
+ *
+ * Once enabled, every PROFILE_OPERATION scope reads the calling thread's counters on
+ * entry and exit and charges the difference to its Operation. Counters come from the
+ * best source that works on the machine:
+ *
+ * - Hardware: perf_event_open group of cycles, instructions, L1D read misses, LLC
+ *   misses, dTLB read misses and branch misses (events the PMU lacks are left out);
+ * - Software: perf software events (task clock, page faults, context switches, CPU
+ *   migrations), for virtual machines without a PMU;
+ * - Rusage: thread CPU time, minor/major faults and context switches from
+ *   clock_gettime/getrusage, when perf_event_open is not permitted at all.
+ *
+ * Each thread opens its own counters on first use; a read costs one system call, so
+ * this layer is off by default, unlike the counters of PerfCounters.hpp. Values are
+ * inclusive of nested operators and scaled when the kernel multiplexes the group.
+ */
+
+#ifndef HARDWARE_COUNTERS_HPP
+#define HARDWARE_COUNTERS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PerfCounters.hpp"
+
+namespace ProfilingGM {
+
+    /**
+     * @brief Where the counter values come from, best first.
+     */
+    enum class CounterSource {
+        None,     ///< Disabled, or unsupported platform
+        Hardware, ///< perf_event_open hardware events
+        Software, ///< perf_event_open software events
+        Rusage    ///< clock_gettime and getrusage
+    };
+
+    const int MAX_HARDWARE_COUNTERS = 6; ///< Most counters any source provides
+
+    /**
+     * @brief Counter totals of one operation, summed over all threads.
+     */
+    struct HardwareStats {
+        Operation operation;
+        uint64_t calls;               ///< Invocations that were measured
+        std::vector<uint64_t> values; ///< One per counterNames() entry
+    };
+
+    /**
+     * @class HardwareScope
+     * @brief Charges the counter deltas over its lifetime to an operation. Used by PROFILE_OPERATION.
+     */
+    class HardwareScope {
+    private:
+        Operation operation;
+        uint64_t start[MAX_HARDWARE_COUNTERS + 2]; ///< Counter values, then time enabled and time running
+        unsigned generation; ///< Counter configuration the start sample belongs to
+        bool active;
+
+    public:
+        explicit HardwareScope(Operation operation);
+        ~HardwareScope();
+        HardwareScope(const HardwareScope&) = delete;
+        HardwareScope& operator=(const HardwareScope&) = delete;
+    };
+
+    /**
+     * @brief Starts attributing counters, trying `preferred` and then the weaker sources.
+     * Earlier totals are discarded.
+     * @return The source in use; None if nothing could be opened.
+     */
+    CounterSource enableHardwareCounters(CounterSource preferred = CounterSource::Hardware);
+
+    void disableHardwareCounters(); ///< Stops attributing; totals are kept
+    CounterSource counterSource(); ///< Source in use, None while disabled
+    std::vector<std::string> counterNames(); ///< Names of the counters of the current source, such as "cycles"
+
+    std::vector<HardwareStats> hardwareSnapshot(); ///< Totals of every operation, in enum order
+    HardwareStats hardwareStats(Operation operation); ///< Totals of one operation
+    void resetHardwareCounters(); ///< Zeroes all totals
+
+} // namespace ProfilingGM
+
+#endif
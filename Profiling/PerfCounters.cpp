@@ -0,0 +1,308 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief Implements the thread-local operator counters, snapshots and exporters.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "PerfCounters.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ProfilingGM {
+
+    namespace {
+        enum Field { CALLS, TICKS, MAX_TICKS, BYTES, FLOPS, ALLOCATIONS, PEAK_TRANSIENT, FIELD_COUNT };
+
+        const char* const NAMES[] = {
+            "matrix_add", "matrix_subtract", "matrix_multiply", "matrix_hadamard", "matrix_negate",
+            "matrix_add_assign", "matrix_subtract_assign",
+            "matrix_scale", "matrix_scale_assign", "matrix_modulo", "matrix_modulo_assign",
+            "matrix_divide", "matrix_divide_assign",
+            "matrix_increment", "matrix_decrement", "matrix_power", "matrix_transpose", "matrix_determinant",
+            "matrix_sum", "matrix_inverse", "matrix_cholesky", "matrix_qr", "matrix_eigen", "matrix_real_power",
+            "matrix_norm", "matrix_vector_multiply", "matrix_multi_vector_multiply",
+            "vector_add", "vector_subtract", "vector_add_assign", "vector_subtract_assign", "vector_hadamard",
+            "vector_dot", "vector_negate", "vector_scale", "vector_scale_assign", "vector_modulo",
+            "vector_modulo_assign", "vector_divide", "vector_divide_assign", "vector_increment",
+            "vector_decrement", "vector_sum", "vector_norm", "vector_axpy",
+            "vector_axpby", "vector_scale_add", "vector_transpose_columns"
+        };
+        static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == OPERATION_COUNT, "one name per Operation");
+
+        uint64_t nanosecondsNow() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// Raw tick counter: the TSC on x86 (a few cycles to read), nanoseconds elsewhere.
+        uint64_t ticksNow() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return nanosecondsNow();
+#endif
+        }
+
+        /// Nanoseconds per tick, measured once over 5 ms of the steady clock.
+        double calibrateTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+            uint64_t startTicks = ticksNow();
+            uint64_t startNanoseconds = nanosecondsNow();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            uint64_t ticks = ticksNow() - startTicks;
+            uint64_t nanoseconds = nanosecondsNow() - startNanoseconds;
+            return ticks > 0 ? static_cast<double>(nanoseconds) / static_cast<double>(ticks) : 1.0;
+#else
+            return 1.0;
+#endif
+        }
+
+        /// Counters of one thread. Only the owning thread writes; snapshots read concurrently.
+        struct ThreadCounters {
+            std::atomic<uint64_t> values[OPERATION_COUNT][FIELD_COUNT];
+
+            ThreadCounters() {
+                for (auto& operation : values)
+                    for (auto& value : operation)
+                        value.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadCounters*> live;
+            uint64_t retired[OPERATION_COUNT][FIELD_COUNT] = {}; ///< Counters of exited threads
+            std::atomic<bool> enabled{true};
+            const double nanosecondsPerTick = calibrateTicks(); ///< Fixed for the run, so snapshots never wait
+        };
+
+        /// Never destroyed: threads may exit after static destruction has begun.
+        Registry& registry() {
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+
+        /// Creates the registry (and calibrates the tick counter) at startup, not in the first profiled call.
+        const Registry& startupRegistry = registry();
+
+        void merge(uint64_t (&into)[OPERATION_COUNT][FIELD_COUNT], const ThreadCounters& from) {
+            for (int op = 0; op < OPERATION_COUNT; ++op)
+                for (int field = 0; field < FIELD_COUNT; ++field) {
+                    uint64_t value = from.values[op][field].load(std::memory_order_relaxed);
+                    if (field == MAX_TICKS || field == PEAK_TRANSIENT)
+                        into[op][field] = value > into[op][field] ? value : into[op][field];
+                    else
+                        into[op][field] += value;
+                }
+        }
+
+        /// Registers the thread's counters on first use and folds them into `retired` at exit.
+        struct ThreadSlot {
+            ThreadCounters counters;
+
+            ThreadSlot() {
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.live.push_back(&counters);
+            }
+
+            ~ThreadSlot() {
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                merge(shared.retired, counters);
+                for (size_t i = 0; i < shared.live.size(); ++i)
+                    if (shared.live[i] == &counters) {
+                        shared.live[i] = shared.live.back();
+                        shared.live.pop_back();
+                        break;
+                    }
+            }
+        };
+
+        thread_local ThreadSlot slot;
+        thread_local ScopedOperation* current = nullptr;
+        thread_local int64_t threadLive = 0; ///< Bytes allocated minus bytes released by this thread
+        thread_local int64_t threadPeak = 0; ///< Highest threadLive since the innermost scope opened
+
+        void raise(std::atomic<uint64_t>& counter, uint64_t value) {
+            if (value > counter.load(std::memory_order_relaxed))
+                counter.store(value, std::memory_order_relaxed);
+        }
+
+        void add(std::atomic<uint64_t>& counter, uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+    }
+
+    const char* operationName(Operation operation) {
+        int index = static_cast<int>(operation);
+        return index >= 0 && index < OPERATION_COUNT ? NAMES[index] : "unknown";
+    }
+
+    ScopedOperation::ScopedOperation(Operation operation, uint64_t bytes, uint64_t flops)
+        : operation(operation), start(0), bytes(bytes), flops(flops), childBytes(0), childFlops(0),
+          allocations(0), liveAtStart(0), outerPeak(0), parent(nullptr),
+          active(registry().enabled.load(std::memory_order_relaxed)) {
+        if (!active)
+            return;
+        liveAtStart = threadLive;
+        outerPeak = threadPeak;
+        threadPeak = threadLive;
+        parent = current;
+        current = this;
+        start = ticksNow();
+    }
+
+    ScopedOperation::~ScopedOperation() {
+        if (!active)
+            return;
+        uint64_t elapsed = ticksNow() - start;
+        if (bytes == 0 && flops == 0) {
+            bytes = childBytes;
+            flops = childFlops;
+        }
+        std::atomic<uint64_t>* values = slot.counters.values[static_cast<int>(operation)];
+        add(values[CALLS], 1);
+        add(values[TICKS], elapsed);
+        raise(values[MAX_TICKS], elapsed);
+        add(values[BYTES], bytes);
+        add(values[FLOPS], flops);
+        add(values[ALLOCATIONS], allocations);
+        raise(values[PEAK_TRANSIENT], static_cast<uint64_t>(threadPeak - liveAtStart));
+        if (outerPeak > threadPeak)
+            threadPeak = outerPeak;
+        current = parent;
+        if (parent) {
+            parent->childBytes += bytes;
+            parent->childFlops += flops;
+            parent->allocations += allocations;
+        }
+    }
+
+    void ScopedOperation::countAllocation(std::size_t bytes) {
+        threadLive += static_cast<int64_t>(bytes);
+        if (threadLive > threadPeak)
+            threadPeak = threadLive;
+        if (current)
+            ++current->allocations;
+    }
+
+    void ScopedOperation::countRelease(std::size_t bytes) {
+        threadLive -= static_cast<int64_t>(bytes);
+    }
+
+    std::vector<OperationStats> snapshot() {
+        uint64_t totals[OPERATION_COUNT][FIELD_COUNT] = {};
+        {
+            Registry& shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            for (int op = 0; op < OPERATION_COUNT; ++op)
+                for (int field = 0; field < FIELD_COUNT; ++field)
+                    totals[op][field] = shared.retired[op][field];
+            for (const ThreadCounters* counters : shared.live)
+                merge(totals, *counters);
+        }
+        double scale = registry().nanosecondsPerTick;
+        std::vector<OperationStats> result;
+        result.reserve(OPERATION_COUNT);
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            const uint64_t* values = totals[op];
+            result.push_back(OperationStats{
+                static_cast<Operation>(op), values[CALLS],
+                static_cast<uint64_t>(static_cast<double>(values[TICKS]) * scale),
+                static_cast<uint64_t>(static_cast<double>(values[MAX_TICKS]) * scale),
+                values[BYTES], values[FLOPS], values[ALLOCATIONS], values[PEAK_TRANSIENT]});
+        }
+        return result;
+    }
+
+    OperationStats stats(Operation operation) {
+        return snapshot()[static_cast<int>(operation)];
+    }
+
+    void reset() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (auto& operation : shared.retired)
+            for (auto& value : operation)
+                value = 0;
+        for (ThreadCounters* counters : shared.live)
+            for (auto& operation : counters->values)
+                for (auto& value : operation)
+                    value.store(0, std::memory_order_relaxed);
+    }
+
+    bool enabled() {
+        return registry().enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled) {
+        registry().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::string toJson(const std::vector<OperationStats>& stats) {
+        std::ostringstream out;
+        out << '{';
+        bool first = true;
+        for (const OperationStats& entry : stats) {
+            if (entry.calls == 0)
+                continue;
+            out << (first ? "" : ", ") << '"' << operationName(entry.operation) << "\": {"
+                << "\"calls\": " << entry.calls
+                << ", \"total_ns\": " << entry.totalNanoseconds
+                << ", \"max_ns\": " << entry.maxNanoseconds
+                << ", \"bytes\": " << entry.bytes
+                << ", \"flops\": " << entry.flops
+                << ", \"allocations\": " << entry.allocations
+                << ", \"peak_transient_bytes\": " << entry.peakTransientBytes << '}';
+            first = false;
+        }
+        out << '}';
+        return out.str();
+    }
+
+    std::string toPrometheus(const std::vector<OperationStats>& stats) {
+        struct Metric {
+            const char* name;
+            const char* type;
+            const char* help;
+            double (*value)(const OperationStats&);
+        };
+        static const Metric metrics[] = {
+            {"matrix_operation_calls_total", "counter", "Operator invocations.",
+             [](const OperationStats& s) { return static_cast<double>(s.calls); }},
+            {"matrix_operation_seconds_total", "counter", "Time spent in the operator, nested calls included.",
+             [](const OperationStats& s) { return static_cast<double>(s.totalNanoseconds) * 1e-9; }},
+            {"matrix_operation_max_seconds", "gauge", "Longest single invocation.",
+             [](const OperationStats& s) { return static_cast<double>(s.maxNanoseconds) * 1e-9; }},
+            {"matrix_operation_bytes_total", "counter", "Element bytes read and written.",
+             [](const OperationStats& s) { return static_cast<double>(s.bytes); }},
+            {"matrix_operation_flops_total", "counter", "Arithmetic operations on elements.",
+             [](const OperationStats& s) { return static_cast<double>(s.flops); }},
+            {"matrix_operation_allocations_total", "counter", "Buffers allocated.",
+             [](const OperationStats& s) { return static_cast<double>(s.allocations); }},
+            {"matrix_operation_peak_transient_bytes", "gauge", "Largest rise of live memory during one invocation.",
+             [](const OperationStats& s) { return static_cast<double>(s.peakTransientBytes); }},
+        };
+        std::ostringstream out;
+        out.precision(17);
+        for (const Metric& metric : metrics) {
+            out << "# HELP " << metric.name << ' ' << metric.help << '\n'
+                << "# TYPE " << metric.name << ' ' << metric.type << '\n';
+            for (const OperationStats& entry : stats)
+                out << metric.name << "{operation=\"" << operationName(entry.operation) << "\"} "
+                    << metric.value(entry) << '\n';
+        }
+        return out.str();
+    }
+
+} // namespace ProfilingGM
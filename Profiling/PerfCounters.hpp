@@ -0,0 +1,155 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Always-on per-operator performance counters for SquareMatrix and Vector.
+ *
+ * Every instrumented operator opens a ScopedOperation (through PROFILE_OPERATION) that
+ * records, for its Operation: call count, total and maximum duration, bytes touched,
+ * floating-point operations and cell-buffer allocations. Counters are accumulated in
+ * thread-local slots with plain relaxed stores (no shared cache lines, no locks), and
+ * durations come from the time-stamp counter where available, so an operator pays a
+ * few nanoseconds. Snapshots sum the slots of all threads, including exited ones.
+ *
+ * Scopes nest. Durations and allocations are inclusive; bytes and FLOPs are the
+ * operator's own estimate, or, for operators without one (operator^), the sum over the
+ * operators they call. Allocations are charged to the scope of the thread that makes them,
+ * and so is the peak transient memory: the largest rise in the bytes that thread holds
+ * (MemoryAccounting.hpp) during one call.
+ *
+ * PROFILE_OPERATION also opens a TraceSpan, so operators appear in traces (Trace.hpp),
+ * and a HardwareScope, which reads hardware counters once they are enabled (HardwareCounters.hpp).
+ *
+ * Building with -DMATRIX_DISABLE_PROFILING removes the instrumentation entirely;
+ * setEnabled(false) turns it off at runtime.
+ *
+ * Example: `std::cout << ProfilingGM::toPrometheus(ProfilingGM::snapshot());`
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Trace.hpp"
+
+namespace ProfilingGM {
+
+    /**
+     * @brief The instrumented operators and Vector kernels.
+     */
+    enum class Operation : int {
+        MatrixAdd, MatrixSubtract, MatrixMultiply, MatrixHadamard, MatrixNegate,
+        MatrixAddAssign, MatrixSubtractAssign,
+        MatrixScale, MatrixScaleAssign, MatrixModulo, MatrixModuloAssign, MatrixDivide, MatrixDivideAssign,
+        MatrixIncrement, MatrixDecrement, MatrixPower, MatrixTranspose, MatrixDeterminant, MatrixSum,
+        MatrixInverse, MatrixCholesky, MatrixQR, MatrixEigen, MatrixRealPower, MatrixNorm,
+        MatrixVectorMultiply, MatrixMultiVectorMultiply,
+        VectorAdd, VectorSubtract, VectorAddAssign, VectorSubtractAssign, VectorHadamard, VectorDot,
+        VectorNegate, VectorScale, VectorScaleAssign, VectorModulo, VectorModuloAssign,
+        VectorDivide, VectorDivideAssign, VectorIncrement, VectorDecrement, VectorSum, VectorNorm,
+        VectorAxpy, VectorAxpby, VectorScaleAdd,
+        VectorTransposeColumns,
+        Count ///< Number of operations, not an operation
+    };
+
+    const int OPERATION_COUNT = static_cast<int>(Operation::Count);
+
+    /**
+     * @brief Name used in the JSON and Prometheus output, such as "matrix_multiply".
+     */
+    const char* operationName(Operation operation);
+
+    /**
+     * @brief Trace category of an operation: Vector kernels are SpanKind::Kernel.
+     */
+    inline SpanKind spanKind(Operation operation) {
+        return operation >= Operation::VectorAdd ? SpanKind::Kernel : SpanKind::Operator;
+    }
+
+    /**
+     * @brief Counters of one operation, summed over all threads.
+     */
+    struct OperationStats {
+        Operation operation;
+        uint64_t calls;
+        uint64_t totalNanoseconds;
+        uint64_t maxNanoseconds;   ///< Longest single call
+        uint64_t bytes;            ///< Bytes read and written (element storage, estimated per operation)
+        uint64_t flops;            ///< Arithmetic operations on elements
+        uint64_t allocations;      ///< Cell buffers and row arrays allocated
+        uint64_t peakTransientBytes; ///< Largest rise of the calling thread's live bytes during one call
+    };
+
+    /**
+     * @class ScopedOperation
+     * @brief Charges the lifetime of this object to an operation. Use through PROFILE_OPERATION.
+     */
+    class ScopedOperation {
+    private:
+        Operation operation;
+        uint64_t start;            ///< Tick counter at construction
+        uint64_t bytes;            ///< Own estimate
+        uint64_t flops;            ///< Own estimate
+        uint64_t childBytes;       ///< Reported by nested scopes
+        uint64_t childFlops;       ///< Reported by nested scopes
+        uint64_t allocations;
+        int64_t liveAtStart;       ///< Thread's live bytes at construction
+        int64_t outerPeak;         ///< Thread's peak before this scope, restored at destruction
+        ScopedOperation* parent;   ///< Enclosing scope of this thread
+        bool active;               ///< Counters were enabled at construction
+
+    public:
+        ScopedOperation(Operation operation, uint64_t bytes = 0, uint64_t flops = 0);
+        ~ScopedOperation();
+        ScopedOperation(const ScopedOperation&) = delete;
+        ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+        /**
+         * @brief Charges an allocation of `bytes` to the calling thread's innermost scope, if any.
+         */
+        static void countAllocation(std::size_t bytes);
+
+        /**
+         * @brief Notes that the calling thread released `bytes`.
+         */
+        static void countRelease(std::size_t bytes);
+    };
+
+    std::vector<OperationStats> snapshot(); ///< Counters of every operation, in enum order
+    OperationStats stats(Operation operation); ///< Counters of one operation
+
+    /**
+     * @brief Zeroes all counters. Increments made concurrently by running operations may be kept or lost.
+     */
+    void reset();
+
+    bool enabled(); ///< Whether new scopes record anything (default true)
+    void setEnabled(bool enabled); ///< Turns recording on or off for scopes opened afterwards
+
+    /**
+     * @brief `{"matrix_add": {"calls": 3, "total_ns": ..., ...}, ...}` for operations that were called.
+     */
+    std::string toJson(const std::vector<OperationStats>& stats);
+
+    /**
+     * @brief Prometheus text exposition format, one labelled sample per operation and counter.
+     */
+    std::string toPrometheus(const std::vector<OperationStats>& stats);
+
+} // namespace ProfilingGM
+
+#include "HardwareCounters.hpp" // needs Operation, declared above
+
+#ifndef MATRIX_DISABLE_PROFILING
+#define PROFILE_OPERATION(operation, bytes, flops) \
+    ProfilingGM::ScopedOperation profileScope(ProfilingGM::Operation::operation, (bytes), (flops)); \
+    ProfilingGM::TraceSpan profileSpan(ProfilingGM::operationName(ProfilingGM::Operation::operation), \
+                                       ProfilingGM::spanKind(ProfilingGM::Operation::operation)); \
+    ProfilingGM::HardwareScope profileCounters(ProfilingGM::Operation::operation)
+#else
+#define PROFILE_OPERATION(operation, bytes, flops) do {} while (0)
+#endif
+
+#endif
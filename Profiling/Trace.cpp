@@ -0,0 +1,219 @@
+/**
+ * @file Trace.cpp
+ * @brief Implements per-thread span buffers and the Chrome trace-event writer.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#include "Trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../Exception/MyExceptions.hpp"
+
+namespace ProfilingGM {
+
+    namespace {
+        struct Event {
+            const char* name;
+            SpanKind kind;
+            uint64_t start;    ///< Nanoseconds, steady clock
+            uint64_t duration; ///< Nanoseconds
+        };
+
+        /// Events of one thread. The owner appends; writers read under the same mutex.
+        struct ThreadTrace {
+            std::mutex mutex;
+            std::vector<Event> events;
+            uint64_t dropped = 0;
+            int id;
+            std::string name;
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadTrace>> threads; ///< Kept after their thread exits
+            std::atomic<bool> tracing{false};
+            std::atomic<bool> kernels{false};
+            uint64_t origin = 0; ///< Time of startTracing(), the trace's zero
+            int nextId = 1;
+        };
+
+        /// Never destroyed: spans may close after static destruction has begun.
+        Registry& registry() {
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+
+        thread_local ThreadTrace* local = nullptr;
+
+        ThreadTrace& localTrace() {
+            if (!local) {
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.threads.push_back(std::unique_ptr<ThreadTrace>(new ThreadTrace()));
+                local = shared.threads.back().get();
+                local->id = shared.nextId++;
+                local->name = "thread " + std::to_string(local->id);
+            }
+            return *local;
+        }
+
+        uint64_t nanosecondsNow() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        const char* categoryName(SpanKind kind) {
+            switch (kind) {
+                case SpanKind::Operator: return "operator";
+                case SpanKind::Kernel: return "kernel";
+                case SpanKind::Task: return "task";
+                default: return "phase";
+            }
+        }
+
+        void writeEscaped(std::ostream& out, const std::string& text) {
+            for (char c : text) {
+                if (c == '"' || c == '\\')
+                    out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    out << ' ';
+                else
+                    out << c;
+            }
+        }
+
+        /// Microseconds with nanosecond precision, as the format expects.
+        void writeMicroseconds(std::ostream& out, int64_t nanoseconds) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+            out << buffer;
+        }
+
+        /// Traces the whole run when MATRIX_TRACE names an output file.
+        struct EnvironmentTrace {
+            std::string path;
+
+            EnvironmentTrace() {
+                if (const char* env = std::getenv("MATRIX_TRACE")) {
+                    path = env;
+                    startTracing();
+                }
+            }
+
+            ~EnvironmentTrace() {
+                if (path.empty())
+                    return;
+                MATRIX_TRY {
+                    writeTrace(path);
+                } MATRIX_CATCH_ALL {
+                    // Nothing sensible to report during shutdown.
+                }
+            }
+        };
+
+        EnvironmentTrace environmentTrace;
+    }
+
+    TraceSpan::TraceSpan(const char* name, SpanKind kind) : name(name), kind(kind), start(0), active(false) {
+        Registry& shared = registry();
+        if (!shared.tracing.load(std::memory_order_relaxed))
+            return;
+        if (kind == SpanKind::Kernel && !shared.kernels.load(std::memory_order_relaxed))
+            return;
+        active = true;
+        start = nanosecondsNow();
+    }
+
+    TraceSpan::~TraceSpan() {
+        if (!active)
+            return;
+        uint64_t end = nanosecondsNow();
+        ThreadTrace& trace = localTrace();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+        if (trace.events.size() >= static_cast<size_t>(MAX_TRACE_EVENTS_PER_THREAD)) {
+            ++trace.dropped;
+            return;
+        }
+        trace.events.push_back(Event{name, kind, start, end - start});
+    }
+
+    void startTracing(bool includeKernels) {
+        clearTrace();
+        Registry& shared = registry();
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.origin = nanosecondsNow();
+        }
+        shared.kernels.store(includeKernels, std::memory_order_relaxed);
+        shared.tracing.store(true, std::memory_order_relaxed);
+    }
+
+    void stopTracing() {
+        registry().tracing.store(false, std::memory_order_relaxed);
+    }
+
+    bool isTracing() {
+        return registry().tracing.load(std::memory_order_relaxed);
+    }
+
+    void clearTrace() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (const auto& thread : shared.threads) {
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            thread->events.clear();
+            thread->dropped = 0;
+        }
+    }
+
+    void setThreadName(const std::string& name) {
+        ThreadTrace& trace = localTrace();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+        trace.name = name;
+    }
+
+    void writeTrace(std::ostream& out) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        uint64_t dropped = 0;
+        bool first = true;
+        out << "{\"traceEvents\": [";
+        for (const auto& thread : shared.threads) {
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                << thread->id << ", \"args\": {\"name\": \"";
+            writeEscaped(out, thread->name);
+            out << "\"}}";
+            first = false;
+            for (const Event& event : thread->events) {
+                out << ",\n{\"name\": \"";
+                writeEscaped(out, event.name);
+                out << "\", \"cat\": \"" << categoryName(event.kind) << "\", \"ph\": \"X\", \"ts\": ";
+                writeMicroseconds(out, static_cast<int64_t>(event.start - shared.origin));
+                out << ", \"dur\": ";
+                writeMicroseconds(out, static_cast<int64_t>(event.duration));
+                out << ", \"pid\": 1, \"tid\": " << thread->id << '}';
+            }
+            dropped += thread->dropped;
+        }
+        out << "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+    }
+
+    void writeTrace(const std::string& path) {
+        std::ofstream file(path);
+        if (!file)
+            MATRIX_THROW(MyLogicError("Cannot open trace file"));
+        writeTrace(file);
+        if (!file)
+            MATRIX_THROW(MyLogicError("Cannot write trace file"));
+    }
+
+} // namespace ProfilingGM
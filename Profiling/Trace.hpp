@@ -0,0 +1,97 @@
+/**
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ * @brief Scoped tracing spans exported in Chrome trace-event format.
+ *
+ * While tracing is on, every instrumented SquareMatrix operator (PROFILE_OPERATION)
+ * and every internal phase marked with TRACE_SPAN records a complete ("X") event with
+ * its start and duration on the calling thread's track. Scheduler tasks are recorded
+ * too, so the workers of a parallel operator show up as their own tracks underneath.
+ * The JSON written by writeTrace opens directly in Perfetto or chrome://tracing.
+ *
+ * Vector kernels run millions of times inside one matrix operator, so their spans are
+ * only kept when tracing is started with `includeKernels`.
+ *
+ * Setting MATRIX_TRACE=<file> traces the whole process and writes the file at exit.
+ *
+ * Example:
+ *     ProfilingGM::startTracing();
+ *     SquareMatrix p = a ^ 10;
+ *     ProfilingGM::writeTrace("matrix.json");
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ProfilingGM {
+
+    /**
+     * @brief What a span covers; exported as the event category.
+     */
+    enum class SpanKind {
+        Operator, ///< A public SquareMatrix operator
+        Phase,    ///< A step inside an operator ("transpose columns", "elimination")
+        Kernel,   ///< A Vector kernel; recorded only when kernels are included
+        Task      ///< A scheduler task run by a worker or a helping thread
+    };
+
+    /**
+     * @class TraceSpan
+     * @brief Records one event covering its own lifetime, if tracing was on when it was created.
+     */
+    class TraceSpan {
+    private:
+        const char* name; ///< Static string, not copied
+        SpanKind kind;
+        uint64_t start;   ///< Nanoseconds, steady clock
+        bool active;
+
+    public:
+        explicit TraceSpan(const char* name, SpanKind kind = SpanKind::Phase);
+        ~TraceSpan();
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+    };
+
+    /**
+     * @brief Discards earlier events and starts recording spans.
+     * @param includeKernels Also record the Vector kernels (large traces).
+     */
+    void startTracing(bool includeKernels = false);
+    void stopTracing(); ///< Stops recording; recorded events are kept
+    bool isTracing(); ///< Whether new spans are recorded
+    void clearTrace(); ///< Discards all recorded events
+
+    /**
+     * @brief Names the calling thread's track (default "thread <id>").
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief Writes the recorded events as Chrome trace-event JSON.
+     */
+    void writeTrace(std::ostream& out);
+
+    /**
+     * @brief Writes the recorded events to `path`.
+     * @throws MyLogicError if the file cannot be written.
+     */
+    void writeTrace(const std::string& path);
+
+    const int MAX_TRACE_EVENTS_PER_THREAD = 1 << 20; ///< Later events of a thread are dropped and counted
+
+} // namespace ProfilingGM
+
+#ifndef MATRIX_DISABLE_PROFILING
+#define TRACE_SPAN_CONCAT_(a, b) a##b
+#define TRACE_SPAN_NAME_(line) TRACE_SPAN_CONCAT_(traceSpan, line)
+#define TRACE_SPAN(...) ProfilingGM::TraceSpan TRACE_SPAN_NAME_(__LINE__)(__VA_ARGS__)
+#else
+#define TRACE_SPAN(...) do {} while (0)
+#endif
+
+#endif
@@ -10,10 +10,13 @@
  * - Supports two logging levels: INFO and DEBUG
  * - Logs are written to a file named "log.txt" (overwritten on each run)
  * - Allows compile-time control of log verbosity using GLOBAL_LOG_LEVEL
+ * - Thread-safe: each message is written under one mutex, so lines from
+ *   parallel matrix operations never interleave
  *
  * Components:
  * - `enum class LogLevel`: Defines available log levels
  * - `getLogStream()`: Returns a reference to a singleton log file stream
+ * - `getLogMutex()`: Returns the mutex guarding the log file stream
  * - `LOG(level, msg)`: Macro for writing log messages conditionally based on level
  *
  * Usage Example:
@@ -32,6 +35,7 @@
  
  #include <iostream>
  #include <fstream>
+ #include <mutex>
  
  enum class LogLevel {
      INFO  = 0,
@@ -42,6 +46,11 @@
      static std::ofstream logFile("log.txt", std::ios::trunc); 
      return logFile;
  }
+
+ inline std::mutex& getLogMutex() {
+     static std::mutex logMutex;
+     return logMutex;
+ }
  
  #ifndef GLOBAL_LOG_LEVEL
  #define GLOBAL_LOG_LEVEL LogLevel::DEBUG
@@ -50,6 +59,7 @@
  #define LOG(level, msg)                                                                 \
      do {                                                                                \
          if (static_cast<int>(level) == static_cast<int>(GLOBAL_LOG_LEVEL)) {           \
+             std::lock_guard<std::mutex> logLock(getLogMutex());                         \
              getLogStream() << "[" << #level << "] " << msg << std::endl;               \
          }                                                                               \
      } while (0)
@@ -15,6 +15,10 @@
  * - Exception handling for invalid dimensions, out-of-range indices,
  *   uninitialized values, and division/modulo by zero
  * - Output formatting using operator<<
+ * - Performance contracts: accounted and heap allocation counts of the
+ *   operators (a replacement operator new counts the latter) and the
+ *   measured growth of their running time with the matrix size, plus an
+ *   absolute time budget for a 200 x 200 determinant
  *
  * Dependencies:
  * - Vector class (used internally to represent rows)
@@ -35,13 +39,88 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <iostream>
 #include <cmath>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
 #include "../Test_And_Log/Logger.hpp"
 #include "../Matrix/SquareMatrix.hpp"
+#include "../Matrix/SquareMatrixBatch.hpp"
+#include "../Matrix/SquareMatrixView.hpp"
+#include "../Matrix/ModSquareMatrix.hpp"
+#include "../Matrix/FixedSquareMatrix.hpp"
+#include "../Parallel/TaskScheduler.hpp"
+#include "../Parallel/NumaTopology.hpp"
+#include "../Memory/HugePages.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Profiling/PerfCounters.hpp"
+#include "../Profiling/Trace.hpp"
+#include <thread>
 #include "doctest.h" 
 #include "../Exception/MyExceptions.hpp"
 using namespace SquareMatrixGM;
 using namespace std;
 
+/// Every heap allocation of the process, counted by the replacement operator new below.
+static std::atomic<uint64_t> heapAllocations(0);
+
+void* operator new(std::size_t bytes) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(bytes ? bytes : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+// The array forms too, in case the runtime (a sanitizer, say) does not route them through the above.
+void* operator new[](std::size_t bytes) {
+    return operator new(bytes);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief Accounted allocations (MemoryAccounting.hpp) made while running `func`.
+ */
+template <typename Func>
+uint64_t allocationsDuring(Func func) {
+    uint64_t before = MemoryGM::memoryStats().allocations;
+    func();
+    return MemoryGM::memoryStats().allocations - before;
+}
+
+/**
+ * @brief Heap allocations of any kind (operator new) made while running `func` on this
+ * thread's behalf; unlike allocationsDuring(), this also sees allocations that bypass
+ * the accounting. Only meaningful for operations that stay on the calling thread.
+ */
+template <typename Func>
+uint64_t heapAllocationsDuring(Func func) {
+    uint64_t before = heapAllocations.load();
+    func();
+    return heapAllocations.load() - before;
+}
+
 
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -176,6 +255,107 @@ TEST_CASE("Transpose operator") {
    
 }
 
+TEST_CASE("Lazy transpose in kernels") {
+    SquareMatrix a(3), b(3);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) {
+            a[i][j] = i * 3 + j + 1;
+            b[i][j] = (i + 1) * (j + 2) % 5;
+        }
+    SquareMatrix bt(3);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            bt[i][j] = b[j][i];
+
+    SquareMatrix lazy = b;
+    ~lazy;
+    SquareMatrix product = a * lazy;
+    SquareMatrix expected = a * bt;
+    SquareMatrix sum = lazy + a;
+    SquareMatrix bothTransposed = lazy - ~SquareMatrix(b);
+    SquareMatrix scaled = lazy * 2.0;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) {
+            CHECK(product[i][j] == expected[i][j]);
+            CHECK(sum[i][j] == bt[i][j] + a[i][j]);
+            CHECK(bothTransposed[i][j] == 0);
+            CHECK(scaled[i][j] == 2 * bt[i][j]);
+        }
+    CHECK(!lazy == doctest::Approx(!b));
+
+    ~~lazy;
+    CHECK(lazy[0][1] == bt[0][1]);
+
+    SquareMatrix partial(2);
+    partial[0][1] = 7;
+    ~partial;
+    CHECK(partial[1][0] == 7);
+    CHECK(partial[1].isInitialized(0));
+    CHECK_FALSE(partial[0].isInitialized(1));
+
+    std::ostringstream out;
+    out << partial;
+    CHECK(out.str() == "[ ] [ ] \n7 [ ] \n");
+
+    // Const members read through the flag: the shared rows are neither detached nor rewritten.
+    const int n = 100;
+    SquareMatrix plain(n), other(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            plain[i][j] = (i * 7 + j * 3) % 11;
+            other[i][j] = (i + 2 * j) % 5;
+        }
+    SquareMatrix flipped = plain;
+    ~flipped;
+    const SquareMatrix& cf = flipped;
+    const SquareMatrix& cp = plain;
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+        readers.emplace_back([&, t] {
+            for (int i = t; i < n; i += 4)
+                for (int j = 0; j < n; ++j)
+                    mismatches += cf[i][j] == cp[j][i] ? 0 : 1;
+        });
+    for (std::thread& reader : readers)
+        reader.join();
+    CHECK(mismatches == 0);
+
+    // The first read of a transposed copy from scheduler tasks: the copy is built on the
+    // scheduler too, whose helping threads run more of these reads meanwhile.
+    SquareMatrix fromTasks = plain;
+    ~fromTasks;
+    const SquareMatrix& ct = fromTasks;
+    ParallelGM::parallelFor(0, n, 1, [&](int i) {
+        for (int j = 0; j < n; ++j)
+            mismatches += ct[i][j] == cp[j][i] ? 0 : 1;
+    });
+    CHECK(mismatches == 0);
+
+    SquareMatrix leftTransposed = flipped * other;
+    SquareMatrix mixedSum = flipped + other;
+    VectorGM::Vector x(n);
+    for (int j = 0; j < n; ++j)
+        x[j] = 1.0 + j % 3;
+    VectorGM::Vector y = cf * x;
+    VectorGM::Vector xs[2] = {x, x * 2.0};
+    SquareMatrix::VectorList ys = cf.multiplyVectors(xs, 2);
+    for (int i = 0; i < n; ++i) {
+        double dot = 0.0, expectedRow = 0.0;
+        for (int j = 0; j < n; ++j) {
+            dot += cp[j][i] * x[j];
+            expectedRow += cp[j][i] * other[j][n - 1 - i];
+        }
+        CHECK(y[i] == doctest::Approx(dot));
+        CHECK(ys[0][i] == doctest::Approx(dot));
+        CHECK(ys[1][i] == doctest::Approx(2 * dot));
+        CHECK(leftTransposed[i][n - 1 - i] == doctest::Approx(expectedRow));
+        CHECK(mixedSum[i][0] == cp[0][i] + other[i][0]);
+    }
+    ~flipped;
+    CHECK(&cf[0] == &cp[0]); // still sharing the untouched rows
+}
+
 TEST_CASE("Determinant operator") {
     SquareMatrix mat(3);
     mat[0][0] = 1; mat[0][1] = 2; mat[0][2] = 3;
@@ -185,6 +365,19 @@ TEST_CASE("Determinant operator") {
     double det = !mat;
 
     CHECK(det == 1);  
+
+    // L * U with unit-diagonal L: the elimination runs its row updates in parallel.
+    const int n = 100;
+    SquareMatrix lower(n), upper(n);
+    double expected = 1.0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            lower[i][j] = i == j ? 1.0 : (j < i ? 0.5 * std::sin(i * 7 + j) : 0.0);
+            upper[i][j] = i == j ? (i % 3 == 0 ? 2.0 : 1.0) : (j > i ? 0.5 * std::cos(i + 3 * j) : 0.0);
+        }
+    for (int i = 0; i < n; i += 3)
+        expected *= 2.0;
+    CHECK(!(lower * upper) == doctest::Approx(expected).epsilon(1e-8));
 }
 
 TEST_CASE("Matrix power") {
@@ -197,6 +390,389 @@ TEST_CASE("Matrix power") {
     CHECK(m2[1][1] == 8);
 }
 
+TEST_CASE("Matrix inverse and negative power") {
+    SquareMatrix m(3);
+    m[0][0] = 0; m[0][1] = 2; m[0][2] = 1;
+    m[1][0] = 1; m[1][1] = 1; m[1][2] = 0;
+    m[2][0] = 3; m[2][1] = 0; m[2][2] = 4;
+
+    SquareMatrix inv = m.inverse();
+    SquareMatrix product = m * inv;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            CHECK(std::abs(product[i][j] - (i == j ? 1.0 : 0.0)) < 1e-12);
+
+    SquareMatrix p(2);
+    p[0][0] = 2; p[0][1] = 0;
+    p[1][0] = 0; p[1][1] = 4;
+
+    SquareMatrix pInv3 = p ^ -3;
+    CHECK(pInv3[0][0] == doctest::Approx(0.125));
+    CHECK(pInv3[1][1] == doctest::Approx(1.0 / 64));
+    CHECK(pInv3[0][1] == 0);
+
+    SquareMatrix back = (p ^ 3) * pInv3;
+    CHECK(back[0][0] == doctest::Approx(1.0));
+    CHECK(back[1][1] == doctest::Approx(1.0));
+}
+
+TEST_CASE("Blocked inverse and relative singularity test") {
+    // Several panels, with row swaps inside and across them.
+    const int n = 100;
+    SquareMatrix m(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            m[i][j] = ((i * 37 + j * 11) % 23) - 11.0 + (i == (j + 7) % n ? 40.0 : 0.0);
+    SquareMatrix inv = m.inverse();
+    SquareMatrix product = m * inv;
+    double worst = 0.0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            worst = std::max(worst, std::abs(product[i][j] - (i == j ? 1.0 : 0.0)));
+    CHECK(worst < 1e-10);
+
+    // Singularity does not depend on the scale of the matrix.
+    SquareMatrix tiny(2);
+    tiny[0][0] = 4e-14; tiny[0][1] = 1e-14;
+    tiny[1][0] = 1e-14; tiny[1][1] = 2e-14;
+    SquareMatrix tinyInv = tiny.inverse();
+    CHECK(tinyInv[0][0] == doctest::Approx(2e14 / 7));
+    CHECK(tiny.power(-1.0)[0][0] == doctest::Approx(2e14 / 7));
+    SquareMatrix nearlySingular(2);
+    nearlySingular[0][0] = 1e12; nearlySingular[0][1] = 1;
+    nearlySingular[1][0] = 1e12; nearlySingular[1][1] = 1 + 1e-9;
+    CHECK_THROWS_AS(nearlySingular.inverse(), MyLogicError);
+    CHECK(((FixedSquareMatrix<double, 2>{{4e-14, 1e-14}, {1e-14, 2e-14}}) ^ -1).get(0, 0) == doctest::Approx(2e14 / 7));
+}
+
+TEST_CASE("Cholesky factorization, determinant and solve") {
+    SquareMatrix a(3);
+    a[0][0] = 4;   a[0][1] = 12;  a[0][2] = -16;
+    a[1][0] = 12;  a[1][1] = 37;  a[1][2] = -43;
+    a[2][0] = -16; a[2][1] = -43; a[2][2] = 98;
+
+    SquareMatrix l = a.cholesky();
+    CHECK(l[0][0] == doctest::Approx(2));
+    CHECK(l[1][0] == doctest::Approx(6));
+    CHECK(l[1][1] == doctest::Approx(1));
+    CHECK(l[2][0] == doctest::Approx(-8));
+    CHECK(l[2][1] == doctest::Approx(5));
+    CHECK(l[2][2] == doctest::Approx(3));
+    CHECK(l[0][2] == 0);
+
+    CHECK(SquareMatrix::choleskyDeterminant(l) == doctest::Approx(!a));
+
+    VectorGM::Vector b(3);
+    b[0] = 1; b[1] = 2; b[2] = 3;
+    VectorGM::Vector x = SquareMatrix::choleskySolve(l, b);
+    for (int i = 0; i < 3; ++i) {
+        double ax = a[i][0] * x[0] + a[i][1] * x[1] + a[i][2] * x[2];
+        CHECK(ax == doctest::Approx(b[i]));
+    }
+
+    SquareMatrix notPd(2);
+    notPd[0][0] = 1; notPd[0][1] = 2;
+    notPd[1][0] = 2; notPd[1][1] = 1;
+    CHECK_THROWS_AS(notPd.cholesky(), MyLogicError);
+
+    SquareMatrix notSym(2);
+    notSym[0][0] = 4; notSym[0][1] = 1;
+    notSym[1][0] = 0; notSym[1][1] = 4;
+    CHECK_THROWS_AS(notSym.cholesky(), MyLogicError);
+
+    const int n = 200; // several 64-wide blocks; the panel solves and trailing updates run in parallel
+    SquareMatrix big(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            big[i][j] = 1.0 / (1 + std::abs(i - j)) + (i == j ? n : 0);
+    SquareMatrix bigL = big.cholesky();
+    for (int i = 0; i < n; i += 9) {
+        for (int j = 0; j <= i; j += 7) {
+            double v = 0.0;
+            for (int p = 0; p <= j; ++p)
+                v += bigL[i][p] * bigL[j][p];
+            CHECK(v == doctest::Approx(big[i][j]));
+        }
+    }
+
+    VectorGM::Vector wrong(2);
+    wrong[0] = 1; wrong[1] = 1;
+    CHECK_THROWS_AS(SquareMatrix::choleskySolve(l, wrong), MyLogicError);
+}
+
+TEST_CASE("Householder QR factorization") {
+    const int n = 150; // several 32-column panels; the trailing updates run in parallel
+    SquareMatrix a(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            a[i][j] = std::sin(i * 1.3 + j * 0.7) + (i == j ? 3.0 : 0.0);
+
+    SquareMatrix q(n), r(n);
+    a.qr(q, r);
+    SquareMatrix qr = q * r;
+    SquareMatrix qtq = ~SquareMatrix(q) * q;
+    for (int i = 0; i < n; i += 3) {
+        for (int j = 0; j < n; j += 5) {
+            CHECK(qr[i][j] == doctest::Approx(a[i][j]));
+            CHECK(std::abs(qtq[i][j] - (i == j ? 1.0 : 0.0)) < 1e-10);
+        }
+        for (int j = 0; j < i; ++j)
+            CHECK(r[i][j] == 0);
+    }
+
+    VectorGM::Vector tau;
+    SquareMatrix factor = a.householderQR(tau);
+    VectorGM::Vector e(n);
+    for (int i = 0; i < n; ++i)
+        e[i] = (i == 1 ? 1.0 : 0.0);
+    VectorGM::Vector qCol = SquareMatrix::qrApplyQ(factor, tau, e, false);
+    for (int i = 0; i < n; ++i)
+        CHECK(qCol[i] == doctest::Approx(q[i][1]));
+
+    VectorGM::Vector b(n);
+    for (int i = 0; i < n; ++i)
+        b[i] = i + 1.0;
+    VectorGM::Vector x = SquareMatrix::qrSolve(factor, tau, b);
+    for (int i = 0; i < n; i += 7) {
+        double ax = 0.0;
+        for (int j = 0; j < n; ++j)
+            ax += a[i][j] * x[j];
+        CHECK(ax == doctest::Approx(b[i]));
+    }
+
+    SquareMatrix uninit(2);
+    CHECK_THROWS_AS(uninit.householderQR(tau), MyLogicError);
+}
+
+TEST_CASE("Symmetric eigensolver and real powers") {
+    SquareMatrix a(3);
+    a[0][0] = 2;  a[0][1] = -1; a[0][2] = 0;
+    a[1][0] = -1; a[1][1] = 2;  a[1][2] = -1;
+    a[2][0] = 0;  a[2][1] = -1; a[2][2] = 2;
+
+    VectorGM::Vector values = a.eigenvalues();
+    CHECK(values[0] == doctest::Approx(2 - std::sqrt(2.0)));
+    CHECK(values[1] == doctest::Approx(2));
+    CHECK(values[2] == doctest::Approx(2 + std::sqrt(2.0)));
+
+    SquareMatrix v(3);
+    VectorGM::Vector withVectors = a.eigen(v);
+    for (int k = 0; k < 3; ++k) {
+        CHECK(withVectors[k] == doctest::Approx(values[k]));
+        for (int i = 0; i < 3; ++i) {
+            double av = a[i][0] * v[0][k] + a[i][1] * v[1][k] + a[i][2] * v[2][k];
+            CHECK(av == doctest::Approx(values[k] * v[i][k]));
+        }
+    }
+
+    SquareMatrix cube = a.power(3);
+    SquareMatrix expected = a ^ 3;
+    SquareMatrix root = a.power(0.5);
+    SquareMatrix squared = root * root;
+    SquareMatrix inv = a.power(-1);
+    SquareMatrix exactInv = a.inverse();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            CHECK(cube[i][j] == doctest::Approx(expected[i][j]));
+            CHECK(squared[i][j] == doctest::Approx(a[i][j]).epsilon(1e-9));
+            CHECK(inv[i][j] == doctest::Approx(exactInv[i][j]));
+        }
+    }
+
+    SquareMatrix indefinite(2);
+    indefinite[0][0] = 0; indefinite[0][1] = 1;
+    indefinite[1][0] = 1; indefinite[1][1] = 0;
+    CHECK_THROWS_AS(indefinite.power(0.5), MyLogicError);
+    CHECK(indefinite.power(2)[0][0] == doctest::Approx(1));
+
+    SquareMatrix notSym(2);
+    notSym[0][0] = 1; notSym[0][1] = 2;
+    notSym[1][0] = 0; notSym[1][1] = 1;
+    CHECK_THROWS_AS(notSym.eigenvalues(), MyLogicError);
+
+    // Dense and large enough for several blocked-tridiagonalization panels, run in parallel.
+    const int n = 120;
+    SquareMatrix big(n);
+    double trace = 0.0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            big[i][j] = std::sin(i + j) + std::cos(0.01 * i * j) + (i == j ? 0.1 * i : 0.0);
+            if (i == j)
+                trace += big[i][j];
+        }
+    SquareMatrix bigVectors(n);
+    VectorGM::Vector bigValues = big.eigen(bigVectors);
+    VectorGM::Vector onlyValues = big.eigenvalues();
+    double total = 0.0;
+    for (int k = 0; k < n; ++k) {
+        total += bigValues[k];
+        CHECK(onlyValues[k] == doctest::Approx(bigValues[k]).epsilon(1e-9));
+    }
+    CHECK(total == doctest::Approx(trace));
+    for (int k = 0; k < n; k += 17) {
+        for (int i = 0; i < n; i += 13) {
+            double av = 0.0;
+            for (int j = 0; j < n; ++j)
+                av += big[i][j] * bigVectors[j][k];
+            CHECK(std::abs(av - bigValues[k] * bigVectors[i][k]) < 1e-9);
+        }
+        for (int l = 0; l < n; l += 29) {
+            double dot = 0.0;
+            for (int i = 0; i < n; ++i)
+                dot += bigVectors[i][k] * bigVectors[i][l];
+            CHECK(std::abs(dot - (k == l ? 1.0 : 0.0)) < 1e-10);
+        }
+    }
+}
+
+TEST_CASE("Batched small-matrix operators") {
+    const int count = 5;
+    SquareMatrixBatch a(3, count), b(3, count);
+    for (int m = 0; m < count; ++m)
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) {
+                a.at(m, i, j) = m + i * 3 + j;
+                b.at(m, i, j) = (i == j ? 2.0 : 0.0) + m * 0.5 * j;
+            }
+
+    SquareMatrixBatch sum = a + b;
+    SquareMatrixBatch product = a * b;
+    SquareMatrixBatch cube = a ^ 3;
+    for (int m = 0; m < count; ++m) {
+        SquareMatrix ma = a.get(m), mb = b.get(m);
+        SquareMatrix expectedSum = ma + mb;
+        SquareMatrix expectedProduct = ma * mb;
+        SquareMatrix expectedCube = ma ^ 3;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) {
+                CHECK(sum.at(m, i, j) == expectedSum[i][j]);
+                CHECK(product.at(m, i, j) == expectedProduct[i][j]);
+                CHECK(cube.at(m, i, j) == expectedCube[i][j]);
+            }
+    }
+
+    SquareMatrix single(3);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            single[i][j] = i * 10 + j;
+    a.set(2, single);
+    ~a;
+    CHECK(a.at(2, 0, 1) == 10);
+    CHECK(a.at(2, 1, 0) == 1);
+    CHECK((a ^ 0).at(4, 1, 1) == 1);
+
+    // Moves hand the interleaved buffer over instead of copying it.
+    SquareMatrixBatch moved = std::move(a);
+    CHECK(moved.at(2, 0, 1) == 10);
+    CHECK(a.getCount() == 0);
+    a = std::move(moved);
+    CHECK(a.at(2, 1, 0) == 1);
+    CHECK(heapAllocationsDuring([&] { SquareMatrixBatch taken = std::move(a); a = std::move(taken); }) == 0);
+    // a^8: the identity, the copy of a, three squarings and one product, each assigned by moving.
+    CHECK(heapAllocationsDuring([&] { SquareMatrixBatch eighth = a ^ 8; }) == 6);
+
+    SquareMatrixBatch other(2, count);
+    CHECK_THROWS_AS(a + other, MyLogicError);
+    CHECK_THROWS_AS(a * other, MyLogicError);
+    CHECK_THROWS_AS(a ^ -1, MyLogicError);
+    CHECK_THROWS_AS(a.at(count, 0, 0), MyOutOfRange);
+    CHECK_THROWS_AS(a.set(0, SquareMatrix(3)), MyLogicError);
+    CHECK_THROWS_AS(SquareMatrixBatch(-1, 2), InvalidArgument);
+}
+
+TEST_CASE("Element-type instantiations") {
+    BasicSquareMatrix<int64_t> fib(2);
+    fib[0][0] = 1; fib[0][1] = 1;
+    fib[1][0] = 1; fib[1][1] = 0;
+    BasicSquareMatrix<int64_t> f90 = fib ^ 90;
+    CHECK(f90[0][1] == 2880067194370816120LL); // exact, beyond double's 53-bit mantissa
+    CHECK((fib ^ 10) > fib);
+    CHECK_THROWS_AS(fib.inverse(), MyLogicError);
+    CHECK_THROWS_AS(fib ^ -1, MyLogicError);
+
+    BasicSquareMatrix<float> f(2);
+    f[0][0] = 4; f[0][1] = 7;
+    f[1][0] = 2; f[1][1] = 6;
+    BasicSquareMatrix<float> fInv = f.inverse();
+    CHECK(fInv[0][0] == doctest::Approx(0.6f));
+    CHECK(fInv[1][0] == doctest::Approx(-0.2f));
+    CHECK(!f == doctest::Approx(10.0f));
+
+    using Complex = std::complex<double>;
+    BasicSquareMatrix<Complex> c(2);
+    c[0][0] = Complex(0, 1); c[0][1] = Complex(1, 0);
+    c[1][0] = Complex(1, 0); c[1][1] = Complex(0, -1);
+    BasicSquareMatrix<Complex> c2 = c * c;
+    CHECK(c2[0][0] == Complex(0, 0));
+    CHECK(c2[0][1] == Complex(0, 0));
+    CHECK(!c == Complex(0, 0));
+    CHECK_THROWS_AS(c % 2, MyLogicError);
+    CHECK_THROWS_AS(c.inverse(), MyLogicError);
+
+    BasicSquareMatrix<int32_t> small(2);
+    small[0][0] = 7; small[0][1] = -7;
+    small[1][0] = 9; small[1][1] = 4;
+    BasicSquareMatrix<int32_t> rem = small % 3;
+    CHECK(rem[0][0] == 1);
+    CHECK(rem[0][1] == -1);
+    CHECK((small / 2)[1][0] == 4);
+}
+
+TEST_CASE("Modular matrices and huge powers") {
+    ModSquareMatrix<1000000007ULL> fib(2);
+    fib.set(0, 0, 1); fib.set(0, 1, 1);
+    fib.set(1, 0, 1); fib.set(1, 1, 0);
+    CHECK((fib ^ 1000000000000000000ULL).get(0, 1) == 209783453ULL);
+
+    const uint64_t mersenne = (1ULL << 61) - 1;
+    ModSquareMatrix<mersenne> big(2);
+    big.set(0, 0, 1); big.set(0, 1, 1);
+    big.set(1, 0, 1); big.set(1, 1, 0);
+    CHECK((big ^ 1000000000000000000ULL).get(0, 1) == 1024960830501646393ULL);
+
+    ModSquareMatrix<998244353ULL> small(2);
+    small.set(0, 0, 1); small.set(0, 1, 1);
+    small.set(1, 0, 1); small.set(1, 1, 0);
+    CHECK((small ^ 0xFFFFFFFFFFFFFFFFULL).get(0, 1) == 495829366ULL);
+    CHECK((small ^ 0) == (small ^ 0) * (small ^ 0));
+
+    BasicSquareMatrix<int64_t> ints(2);
+    ints[0][0] = -1; ints[0][1] = 5000000000LL;
+    ints[1][0] = 7;  ints[1][1] = 0;
+    ModSquareMatrix<1000000007ULL> reduced(ints);
+    CHECK(reduced.get(0, 0) == 1000000006ULL);
+    CHECK(reduced.get(0, 1) == 5000000000ULL % 1000000007ULL);
+    CHECK((reduced + reduced - reduced) == reduced);
+
+    CHECK_THROWS_AS(reduced.get(2, 0), MyOutOfRange);
+    CHECK_THROWS_AS(reduced * ModSquareMatrix<1000000007ULL>(3), MyLogicError);
+
+    // Near 2^61 only about 56 unreduced products fit in 128 bits, so a row of 70 is
+    // accumulated in two runs with a fold in between; compare with one mulmod per term.
+    const int n = 70;
+    ModSquareMatrix<mersenne> x(n), y(n);
+    auto entry = [mersenne](int i, int j, int salt) {
+        return mersenne - 1 - static_cast<uint64_t>((i * 131 + j * 17 + salt) % 1000) * 999983ULL;
+    };
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            x.set(i, j, entry(i, j, 1));
+            y.set(i, j, entry(i, j, 2));
+        }
+    ModSquareMatrix<mersenne> xy = x * y;
+    for (int i = 0; i < n; i += 13)
+        for (int j = 0; j < n; j += 11) {
+            unsigned __int128 expected = 0;
+            for (int k = 0; k < n; ++k)
+                expected = (expected + static_cast<unsigned __int128>(entry(i, k, 1)) * entry(k, j, 2)) % mersenne;
+            CHECK(xy.get(i, j) == static_cast<uint64_t>(expected));
+        }
+
+    SquareMatrix wide(1);
+    wide[0][0] = 6000000001.0;
+    CHECK((wide % 7)[0][0] == 6000000001LL % 7);
+}
+
 TEST_CASE("Increment and Decrement") {
     SquareMatrix m(2);
     m[0][0] = 1; m[0][1] = 2;
@@ -266,6 +842,1050 @@ TEST_CASE("Matrix comparison operators based on sum()") {
     CHECK(c >= a);
 }
 
+TEST_CASE("Cached sum follows every mutation") {
+    SquareMatrix a(2), b(2);
+    a[0][0] = 1; a[0][1] = 2;
+    a[1][0] = 3; a[1][1] = 4;
+    b[0][0] = 2; b[0][1] = 2;
+    b[1][0] = 3; b[1][1] = 3;
+
+    CHECK(a == b);
+    a[1][1] = 5;
+    CHECK(a > b);
+    a -= b;
+    CHECK(a < b);
+    ++a;
+    CHECK(a < b);
+    a *= 10.0;
+    CHECK(a > b);
+    ~a;
+    CHECK(a > b);
+    SquareMatrix copy = a;
+    CHECK(copy == a);
+    a /= 10.0;
+    CHECK(copy > a);
+    copy = a;
+    CHECK(copy == a);
+    a--;
+    CHECK(copy > a);
+
+    // Writes through a row reference taken before the comparison still count.
+    SquareMatrix c = b;
+    SquareMatrix::RowReference held = c[0];
+    CHECK(c == b);
+    held[0] = 100;
+    CHECK(c != b);
+    held += held;
+    CHECK(c > b);
+
+    // Concurrent sums of one matrix agree and fill the cache once for all.
+    SquareMatrix big(96);
+    for (int i = 0; i < 96; ++i)
+        for (int j = 0; j < 96; ++j)
+            big[i][j] = (i + j) % 5;
+    const SquareMatrix& shared = big;
+    std::atomic<int> equal{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+        readers.emplace_back([&] { equal += (shared == big) ? 1 : 0; });
+    for (std::thread& reader : readers)
+        reader.join();
+    CHECK(equal == 4);
+}
+
+TEST_CASE("Copy-on-write storage") {
+    SquareMatrix filled(3);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            filled[i][j] = i * 3 + j;
+
+    // A held row reference detaches before each write, so copies made meanwhile keep
+    // their values and share the rows until then.
+    SquareMatrix::RowReference held = filled[0];
+    SquareMatrix snapshot = filled;
+    const SquareMatrix& cfilled = filled;
+    const SquareMatrix& csnapshot = snapshot;
+    CHECK(&cfilled[0] == &csnapshot[0]);
+    held[0] = 50;
+    CHECK(&cfilled[0] != &csnapshot[0]);
+    CHECK(snapshot[0][0] == 0);
+    CHECK(filled[0][0] == 50);
+    SquareMatrix assigned(1);
+    assigned = filled;
+    held[1] = 60;
+    CHECK(assigned[0][1] == 1);
+    SquareMatrixView whole = filled.block(0, 0, 3); // a writable view detaches before writing too
+    SquareMatrix viewed = filled;
+    whole.set(2, 2, 80);
+    CHECK(viewed[2][2] == 8);
+    held[0] = 0;
+    held[1] = 1;
+    whole.set(2, 2, 8);
+
+    SquareMatrix a = filled;
+    SquareMatrix b = a;
+    const SquareMatrix& ca = a;
+    const SquareMatrix& cb = b;
+    CHECK(&ca[0] == &cb[0]); // copies share rows until written
+
+    b[1][1] = 100;
+    CHECK(&ca[0] != &cb[0]);
+    CHECK(ca[1][1] == 4);
+    CHECK(cb[1][1] == 100);
+
+    SquareMatrix c(1);
+    c = a;
+    c += a;
+    CHECK(ca[2][2] == 8);
+    CHECK(c[2][2] == 16);
+
+    SquareMatrix old = a++;
+    CHECK(old[0][1] == 1);
+    CHECK(a[0][1] == 2);
+    old = a--;
+    CHECK(old[0][1] == 2);
+    CHECK(a[0][1] == 1);
+
+    SquareMatrix t = a;
+    t = ~t;
+    CHECK(t[0][1] == 3);
+    CHECK(a[0][1] == 1);
+    CHECK(a[1][0] == 3);
+
+    a += a; // aliasing a shared operand
+    CHECK(a[2][1] == 14);
+    CHECK(cb[2][1] == 7);
+}
+
+TEST_CASE("Submatrix and minor views") {
+    SquareMatrix m(4);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            m[i][j] = i * 4 + j;
+
+    SquareMatrixView b = m.block(1, 1, 2);
+    CHECK(b.getSize() == 2);
+    CHECK(b.get(0, 0) == 5);
+    CHECK(b.get(1, 1) == 10);
+    b.set(0, 1, 100);
+    CHECK(m[1][2] == 100);
+    b *= 2;
+    CHECK(m[2][2] == 20);
+    CHECK(m[0][0] == 0); // outside the block
+
+    SquareMatrix sum = b + m.block(0, 0, 2);
+    CHECK(sum[0][0] == 10 + 0);
+    CHECK(sum[1][1] == 20 + 10);
+    SquareMatrix id(2);
+    id[0][0] = 1; id[0][1] = 0;
+    id[1][0] = 0; id[1][1] = 1;
+    SquareMatrix prod = id * b;
+    CHECK(prod == b.toMatrix());
+    CHECK((~b).get(0, 1) == b.get(1, 0));
+
+    SquareMatrixView minor = m.minorView(1, 2);
+    CHECK(minor.getSize() == 3);
+    CHECK(minor.get(0, 2) == 3);
+    CHECK(minor.get(1, 1) == 18);
+    CHECK(minor.block(1, 1, 2).get(1, 1) == 15);
+    // Minors nest: the minor of a minor skips two rows and two columns.
+    SquareMatrixView nested = minor.minorView(0, 0); // rows 2, 3 and columns 1, 3 of m
+    CHECK(nested.getSize() == 2);
+    CHECK(nested.get(0, 0) == 18);
+    CHECK(nested.get(0, 1) == 11);
+    CHECK(nested.get(1, 1) == 15);
+    CHECK(minor.minorView(1, 1).get(1, 0) == 12); // rows 0, 3 and columns 0, 3
+    CHECK((~minor).minorView(0, 1).get(0, 0) == 1);
+    CHECK(m.minorView(3, 3).minorView(0, 0).block(1, 0, 1).get(0, 0) == 18);
+    CHECK_THROWS_AS(m.block(3, 3, 2), MyOutOfRange);
+    CHECK_THROWS_AS(minor.get(3, 0), MyOutOfRange);
+
+    // Writes through a view follow copy-on-write and the lazy transpose.
+    SquareMatrix copy = m;
+    m.minorView(0, 0).set(0, 0, -1);
+    CHECK(m[1][1] == -1);
+    CHECK(copy[1][1] == 10);
+    ~copy;
+    copy.block(0, 1, 1).set(0, 0, 42);
+    CHECK(copy[0][1] == 42);
+
+    const SquareMatrix& constM = m;
+    SquareMatrixView readOnly = constM.block(0, 0, 2);
+    CHECK(readOnly.isReadOnly());
+    CHECK_THROWS_AS(readOnly.set(0, 0, 1), MyLogicError);
+
+    // Determinants: closed form for small views, elimination beyond 3x3.
+    SquareMatrix d(5);
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+            d[i][j] = (i == j) ? 4 : 1;
+    CHECK(!d == doctest::Approx(648)); // eigenvalues 3, 3, 3, 3, 8
+    CHECK(!d.minorView(0, 0) == doctest::Approx(3 * 3 * 3 * 7));
+    CHECK(!d.minorView(0, 0).minorView(2, 2) == doctest::Approx(3 * 3 * 6));
+    SquareMatrix wide(10);
+    for (int i = 0; i < 10; ++i)
+        for (int j = 0; j < 10; ++j)
+            wide[i][j] = i * 10 + j;
+    SquareMatrixView deep = wide.minorView(0, 0);
+    for (int k = 1; k < SquareMatrixView::MAX_SKIPS; ++k)
+        deep = deep.minorView(0, 0);
+    CHECK(deep.get(0, 0) == 88);
+    CHECK_THROWS_AS(deep.minorView(0, 0), MyLogicError);
+
+    // Element-wise kernels read both views in place, copying the source only on overlap.
+    SquareMatrix before = wide;
+    wide.block(0, 0, 3).assign(wide.block(1, 1, 3));
+    CHECK(wide[0][0] == before[1][1]);
+    CHECK(wide[2][2] == before[3][3]);
+    wide.block(0, 0, 2) += wide.block(0, 1, 2);
+    CHECK(wide[0][0] == before[1][1] + before[1][2]);
+    CHECK(wide[0][1] == before[1][2] + before[1][3]);
+    wide.block(5, 5, 2) -= wide.block(7, 7, 2); // disjoint: read in place
+    CHECK(wide[6][6] == before[6][6] - before[8][8]);
+    SquareMatrixView whole = wide.block(0, 0, 10);
+    whole -= whole; // the same mapping reads each element before writing it
+    CHECK(wide[4][7] == 0);
+
+    // A view of a whole matrix adds its elements in the same pairwise order as the matrix.
+    SquareMatrix spread(40);
+    for (int i = 0; i < 40; ++i)
+        for (int j = 0; j < 40; ++j)
+            spread[i][j] = 1.0 / (1 + i * 40 + j);
+    const SquareMatrix& cspread = spread;
+    VectorGM::Vector rowSums(40);
+    for (int i = 0; i < 40; ++i)
+        rowSums[i] = cspread[i].sum();
+    CHECK(SquareMatrixView(cspread).sum() == rowSums.sum());
+    CHECK(SquareMatrixView(spread) == cspread);
+
+    BasicSquareMatrix<int64_t> di(5);
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+            di[i][j] = (i == j) ? 4 : 1;
+    di[0][0] = 0;
+    CHECK(!di == -108); // exact fraction-free elimination
+}
+
+static long fibonacciTasks(ParallelGM::TaskScheduler& scheduler, int n) {
+    if (n < 12) {
+        long a = 0, b = 1;
+        for (int i = 0; i < n; ++i) { long c = a + b; a = b; b = c; }
+        return a;
+    }
+    long left = 0;
+    ParallelGM::TaskGroup group(scheduler);
+    group.run([&] { left = fibonacciTasks(scheduler, n - 1); });
+    long right = fibonacciTasks(scheduler, n - 2);
+    group.wait();
+    return left + right;
+}
+
+TEST_CASE("Work-stealing scheduler") {
+    using namespace ParallelGM;
+
+    WorkStealingDeque deque(2);
+    Task a{nullptr, nullptr}, b{nullptr, nullptr}, c{nullptr, nullptr};
+    deque.push(&a); deque.push(&b); deque.push(&c); // grows past the initial capacity
+    CHECK(deque.steal() == &a); // thieves take the oldest task
+    CHECK(deque.pop() == &c);   // the owner takes the newest
+    CHECK(deque.pop() == &b);
+    CHECK(deque.pop() == nullptr);
+    CHECK(deque.steal() == nullptr);
+
+    TaskScheduler scheduler(3);
+    CHECK(scheduler.workerCount() == 3);
+    CHECK(scheduler.autoGrain(1000) == 1000 / 16);
+
+    std::atomic<long> total(0);
+    parallelFor(scheduler, 0, 10000, 0, [&](int i) { total += i; });
+    CHECK(total == 10000L * 9999 / 2);
+
+    // Nested loops share the same workers.
+    std::atomic<int> cells(0);
+    parallelFor(scheduler, 0, 50, 1, [&](int) {
+        parallelFor(scheduler, 0, 50, 1, [&](int) { ++cells; });
+    });
+    CHECK(cells == 2500);
+
+    CHECK(fibonacciTasks(scheduler, 25) == 75025);
+
+    CHECK_THROWS_AS(parallelFor(scheduler, 0, 1000, 10, [](int i) {
+        if (i == 777) throw MyLogicError("task failed");
+    }), MyLogicError);
+
+    TaskGroup group(scheduler);
+    group.run([] { throw MyOutOfRange(); });
+    CHECK_THROWS_AS(group.wait(), MyOutOfRange);
+
+    // Idle workers block on the condition variable; a submission from this thread
+    // must wake one of them, since nobody here helps until the flag is set.
+    for (int round = 0; round < 20; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::atomic<bool> ran(false);
+        TaskGroup woken(scheduler);
+        woken.run([&] { ran = true; });
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!ran && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        CHECK(ran);
+        woken.wait();
+    }
+
+    TaskScheduler inline0(0);
+    int serial = 0;
+    parallelFor(inline0, 0, 100, 0, [&](int) { ++serial; });
+    CHECK(serial == 100);
+    CHECK_THROWS_AS(TaskScheduler(-1), InvalidArgument);
+
+    // Matrix row loops above the threshold run on the shared scheduler.
+    SquareMatrix big(70);
+    for (int i = 0; i < 70; ++i)
+        for (int j = 0; j < 70; ++j)
+            big[i][j] = (i == j) ? 2 : 0;
+    SquareMatrix doubled = big + big;
+    big *= 3;
+    CHECK(doubled[69][69] == 4);
+    CHECK(big[5][5] == 6);
+    CHECK(big[5][6] == 0);
+    CHECK(big.inverse()[10][10] == doctest::Approx(1.0 / 6));
+    CHECK(big == doubled * 1.5);
+}
+
+TEST_CASE("Execution-policy overloads") {
+    using ParallelGM::seq;
+    using ParallelGM::par;
+    using ParallelGM::par_unseq;
+
+    const int n = 80;
+    SquareMatrix a(n), b(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            a[i][j] = i - j;
+            b[i][j] = (i * 7 + j) % 11 + 1;
+        }
+
+    CHECK(add(seq, a, b) == a + b);
+    CHECK(add(par, a, b) == a + b);
+    SquareMatrix sumUnseq = add(par_unseq, a, b);
+    SquareMatrix diffUnseq = subtract(par_unseq, a, b);
+    SquareMatrix prodUnseq = multiplyElements(par_unseq, a, b);
+    SquareMatrix negUnseq = negative(par_unseq, a);
+    CHECK(sumUnseq[3][70] == a[3][70] + b[3][70]);
+    CHECK(diffUnseq[70][3] == a[70][3] - b[70][3]);
+    CHECK(prodUnseq[12][40] == a[12][40] * b[12][40]);
+    CHECK(negUnseq[5][0] == -5);
+    CHECK(subtract(par, a, b) == a - b);
+    CHECK(multiplyElements(par, a, b) == a % b);
+    CHECK(negative(seq, a) == -a);
+
+    SquareMatrix c = a; // in-place overloads detach shared rows like the operators
+    addTo(par_unseq, c, b);
+    CHECK(c[10][20] == a[10][20] + b[10][20]);
+    subtractFrom(par, c, b);
+    scaleInPlace(par_unseq, c, 3.0);
+    CHECK(c[10][20] == 3 * a[10][20]);
+    divideInPlace(par, c, 3.0);
+    increment(par_unseq, c);
+    decrement(seq, c);
+    CHECK(c == a);
+    moduloInPlace(par_unseq, c, 4);
+    CHECK(c[9][0] == 1);
+    CHECK(a[9][0] == 9);
+
+    // Transposed operands are aligned before the row kernels run.
+    SquareMatrix t = b;
+    ~t;
+    SquareMatrix mixed = add(par_unseq, a, t);
+    CHECK(mixed[1][2] == a[1][2] + b[2][1]);
+
+    SquareMatrix partial(2), small(2), big(3);
+    partial[0][0] = 1;
+    small[0][0] = 1; small[0][1] = 2;
+    small[1][0] = 3; small[1][1] = 4;
+    CHECK_THROWS_AS(add(par_unseq, partial, small), MyLogicError);
+    CHECK_THROWS_AS(scaleInPlace(par_unseq, partial, 2.0), MyLogicError);
+    CHECK_THROWS_AS(add(par, small, big), MyLogicError);
+    CHECK_THROWS_AS(divideInPlace(par_unseq, small, 0.0), MyLogicError);
+    CHECK_THROWS_AS(moduloInPlace(par, small, 0), MyLogicError);
+
+    BasicSquareMatrix<int64_t> counts(2);
+    counts[0][0] = 7; counts[0][1] = -7;
+    counts[1][0] = 9; counts[1][1] = 4;
+    moduloInPlace(par_unseq, counts, 3);
+    CHECK(counts[0][1] == -1);
+    CHECK(add(par, counts, counts)[1][0] == 0);
+}
+
+TEST_CASE("NUMA topology and placement") {
+    using namespace ParallelGM;
+
+    CHECK(NumaTopology::parseList("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(NumaTopology::parseList("").empty());
+    CHECK_THROWS_AS(NumaTopology::parseList("3-1"), InvalidArgument);
+    CHECK_THROWS_AS(NumaTopology::parseList("a,b"), InvalidArgument);
+
+    // A fake sysfs tree with a CPU-less memory node.
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "matrix_numa_test";
+    std::filesystem::create_directories(root / "node0");
+    std::filesystem::create_directories(root / "node1");
+    std::filesystem::create_directories(root / "node2");
+    std::ofstream(root / "online") << "0-2\n";
+    std::ofstream(root / "node0" / "cpulist") << "0-1\n";
+    std::ofstream(root / "node1" / "cpulist") << "2,3\n";
+    std::ofstream(root / "node2" / "cpulist") << "\n";
+    NumaTopology fake = NumaTopology::fromSysfs(root.string(), 1);
+    CHECK(fake.nodeCount() == 3);
+    CHECK(fake.cpus(1) == std::vector<int>{2, 3});
+    CHECK(fake.cpus(2).empty());
+    CHECK(fake.nodeOfCpu(3) == 1);
+    CHECK_THROWS_AS(fake.cpus(3), MyOutOfRange);
+    CHECK(fake.nodeId(2) == 2);
+    std::filesystem::remove_all(root);
+
+    // Online kernel node ids need not be contiguous: nodes 0 and 2 are indices 0 and 1.
+    std::filesystem::create_directories(root / "node0");
+    std::filesystem::create_directories(root / "node2");
+    std::ofstream(root / "online") << "0,2\n";
+    std::ofstream(root / "node0" / "cpulist") << "0-1\n";
+    std::ofstream(root / "node2" / "cpulist") << "2-3\n";
+    NumaTopology sparse = NumaTopology::fromSysfs(root.string(), 1);
+    std::filesystem::remove_all(root);
+    CHECK(sparse.nodeCount() == 2);
+    CHECK(sparse.nodeId(1) == 2);
+    CHECK(sparse.nodeIndex(2) == 1);
+    CHECK(sparse.cpus(sparse.nodeIndex(2)) == std::vector<int>{2, 3});
+    CHECK_THROWS_AS(sparse.nodeIndex(1), InvalidArgument);
+    CHECK_THROWS_AS(sparse.nodeId(2), MyOutOfRange);
+    CHECK_THROWS_AS(NumaTopology({0, 0}, {{0}, {1}}), InvalidArgument);
+    CHECK_THROWS_AS(NumaTopology({0}, {{0}, {1}}), InvalidArgument);
+    NumaTopology missing = NumaTopology::fromSysfs(root.string(), 4);
+    CHECK(missing.nodeCount() == 1);
+    CHECK(missing.cpus(0).size() == 4);
+    CHECK(NumaTopology::system().nodeCount() >= 1);
+
+    NumaTopology pair(std::vector<std::vector<int>>{{0}, {1}});
+    CHECK(NumaPlacement::firstTouch().nodeOfRow(5, 10, pair) == 1);
+    CHECK(NumaPlacement::interleave().nodeOfRow(5, 10, pair) == 1);
+    CHECK(NumaPlacement::bind(1).nodeOfRow(0, 10, pair) == 1);
+    CHECK(NumaPlacement::bind(2).nodeOfRow(0, 10, sparse) == 1);
+    CHECK_THROWS_AS(NumaPlacement::bind(1).nodeOfRow(0, 10, sparse), InvalidArgument); // no wrapping
+    CHECK(NumaPlacement::bind(0) != NumaPlacement::bind(1));
+
+    // Workers fill the nodes that have CPUs; node tasks only run there.
+    NumaTopology twoNodes({{0, 1}, {2, 3}, {}});
+    TaskScheduler scheduler(4, twoNodes, false);
+    CHECK(scheduler.nodeCount() == 3);
+    CHECK(scheduler.workersOnNode(0) == 2);
+    CHECK(scheduler.workersOnNode(1) == 2);
+    CHECK(scheduler.workersOnNode(2) == 0);
+    CHECK(scheduler.nodeOfWorker(3) == 1);
+    CHECK(scheduler.currentNode() == -1);
+    std::atomic<int> misplaced(0);
+    TaskGroup group(scheduler);
+    for (int t = 0; t < 40; ++t)
+        group.runOnNode(t % 2, [&scheduler, &misplaced, t] {
+            if (scheduler.currentNode() != t % 2) ++misplaced;
+        });
+    group.wait();
+    CHECK(misplaced == 0);
+    std::vector<int> ranOn(100, -1);
+    parallelForNodes(scheduler, 0, 100, [](int i) { return i < 50 ? 0 : 1; },
+                     [&](int i) { ranOn[i] = scheduler.currentNode(); });
+    CHECK(ranOn[10] == 0);
+    CHECK(ranOn[90] == 1);
+
+    // Placement changes where rows live, never the values.
+    SquareMatrix plain(70);
+    SquareMatrix placed(70, NumaPlacement::interleave());
+    for (int i = 0; i < 70; ++i)
+        for (int j = 0; j < 70; ++j) {
+            plain[i][j] = (i * 7 + j) % 11;
+            placed[i][j] = (i * 7 + j) % 11;
+        }
+    CHECK(placed.getPlacement() == NumaPlacement::interleave());
+    CHECK((placed * placed) == (plain * plain));
+    SquareMatrix sum = placed + plain;
+    CHECK(sum.getPlacement() == NumaPlacement::interleave());
+    CHECK(sum[69][3] == 2 * plain[69][3]);
+    SquareMatrix copy = placed;
+    copy.setPlacement(NumaPlacement::firstTouch());
+    copy *= 2.0;
+    CHECK(copy[12][5] == 2 * placed[12][5]);
+    CHECK(placed[12][5] == plain[12][5]);
+
+    // Bind takes a kernel node id; one that is not online is rejected.
+    const NumaTopology& machine = TaskScheduler::instance().numaTopology();
+    SquareMatrix bound(70, NumaPlacement::bind(machine.nodeId(machine.nodeCount() - 1)));
+    CHECK(bound.getSize() == 70);
+    CHECK_THROWS_AS(SquareMatrix(70, NumaPlacement::bind(1 << 20)), InvalidArgument);
+    CHECK_THROWS_AS(copy.setPlacement(NumaPlacement::bind(1 << 20)), InvalidArgument);
+    CHECK(copy.getPlacement() == NumaPlacement::firstTouch());
+}
+
+TEST_CASE("Huge-page buffers") {
+    using namespace MemoryGM;
+
+    std::size_t threshold = hugePageThreshold();
+    CHECK(threshold == HUGE_PAGE_SIZE);
+    HugePageStats before = hugePageStats();
+
+    setHugePageThreshold(4096);
+    {
+        SquareMatrix big(64); // 64 KiB of cells: one 2 MiB-aligned slab
+        for (int i = 0; i < 64; ++i)
+            for (int j = 0; j < 64; ++j)
+                big[i][j] = i - j;
+        HugePageStats during = hugePageStats();
+        CHECK(during.regions == before.regions + 1);
+        CHECK(during.largeBytes == before.largeBytes + HUGE_PAGE_SIZE);
+        CHECK(during.hugeBackedBytes <= during.largeBytes);
+        CHECK(reinterpret_cast<std::uintptr_t>(&big[0][0]) % HUGE_PAGE_SIZE == 0);
+
+        SquareMatrix copy = big;
+        copy *= 2.0; // detaches into a slab of its own
+        CHECK(hugePageStats().regions == before.regions + 2);
+        CHECK(copy[63][0] == 126);
+        CHECK(big[63][0] == 63);
+        CHECK((big + big) == copy);
+
+        VectorGM::Vector wide(1000); // 16 KB of cells, also above the lowered threshold
+        wide[999] = 1.5;
+        VectorGM::Vector wideCopy = wide;
+        CHECK(wideCopy[999] == 1.5);
+        CHECK(hugePageStats().regions == before.regions + 4); // big, copy and the two vectors
+
+        SquareMatrix spread(64, ParallelGM::NumaPlacement::interleave()); // one buffer per row
+        CHECK(hugePageStats().regions == before.regions + 4);
+    }
+    CHECK(hugePageStats().regions == before.regions);
+    CHECK(hugePageStats().largeBytes == before.largeBytes);
+    setHugePageThreshold(threshold);
+
+    SquareMatrix small(8); // below the default threshold
+    CHECK(hugePageStats().regions == before.regions);
+
+    std::string path = hugetlbfsPath();
+    setHugetlbfsPath("/nonexistent/hugetlbfs");
+    void* fallback = allocate(HUGE_PAGE_SIZE); // falls back to anonymous memory
+    CHECK(hugePageStats().hugetlbfsBytes == before.hugetlbfsBytes);
+    deallocate(fallback, HUGE_PAGE_SIZE);
+    setHugetlbfsPath(path);
+}
+
+TEST_CASE("Performance counters") {
+    using namespace ProfilingGM;
+
+    SquareMatrix a(4), b(4);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j) {
+            a[i][j] = i + j;
+            b[i][j] = i == j ? 2 : 0;
+        }
+    reset();
+    CHECK(stats(Operation::MatrixMultiply).calls == 0);
+
+    SquareMatrix product = a * b;
+    SquareMatrix total = a + b;
+    OperationStats multiply = stats(Operation::MatrixMultiply);
+    CHECK(multiply.calls == 1);
+    CHECK(multiply.flops == 2 * 4 * 4 * 4);
+    CHECK(multiply.bytes == 3 * 16 * sizeof(VectorGM::Cell));
+    CHECK(multiply.allocations >= 5); // row array and four rows of the result, plus transposed columns
+    CHECK(multiply.maxNanoseconds <= multiply.totalNanoseconds);
+    CHECK(stats(Operation::MatrixAdd).calls == 1);
+    CHECK(stats(Operation::VectorDot).calls == 16);
+    CHECK(stats(Operation::VectorDot).flops == 16 * 8);
+
+    // operator^ has no estimate of its own: it is charged the multiplications it runs.
+    reset();
+    SquareMatrix cube = a ^ 3;
+    OperationStats power = stats(Operation::MatrixPower);
+    CHECK(power.calls == 1);
+    CHECK(stats(Operation::MatrixMultiply).calls >= 2);
+    CHECK(power.flops == stats(Operation::MatrixMultiply).flops);
+    CHECK(power.totalNanoseconds >= stats(Operation::MatrixMultiply).totalNanoseconds);
+
+    // Counters of exited threads are kept.
+    std::thread worker([] {
+        VectorGM::Vector v(3);
+        v[0] = 1; v[1] = 2; v[2] = 3;
+        CHECK((v * v) == 14);
+    });
+    worker.join();
+    CHECK(stats(Operation::VectorDot).calls > 0);
+
+    std::string json = toJson(snapshot());
+    CHECK(json.find("\"matrix_power\": {\"calls\": 1,") != std::string::npos);
+    CHECK(json.find("matrix_cholesky") == std::string::npos); // operations never called are omitted
+    std::string text = toPrometheus(snapshot());
+    CHECK(text.find("# TYPE matrix_operation_calls_total counter") != std::string::npos);
+    CHECK(text.find("matrix_operation_calls_total{operation=\"matrix_power\"} 1\n") != std::string::npos);
+
+    setEnabled(false);
+    reset();
+    SquareMatrix quiet = a * b;
+    CHECK(stats(Operation::MatrixMultiply).calls == 0);
+    setEnabled(true);
+    CHECK(enabled());
+    CHECK(std::string(operationName(Operation::VectorTransposeColumns)) == "vector_transpose_columns");
+}
+
+TEST_CASE("Trace-event spans") {
+    using namespace ProfilingGM;
+
+    SquareMatrix a(4);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            a[i][j] = i == j ? 2 : 1;
+
+    CHECK_FALSE(isTracing());
+    SquareMatrix untraced = a * a;
+    std::ostringstream empty;
+    writeTrace(empty);
+    CHECK(empty.str().find("\"ph\": \"X\"") == std::string::npos);
+
+    startTracing();
+    CHECK(isTracing());
+    SquareMatrix cube = a ^ 3;
+    CHECK(!cube == doctest::Approx(125.0)); // det(J + I) = 5
+    ParallelGM::TaskScheduler scheduler(2);
+    std::atomic<int> visited(0);
+    ParallelGM::parallelFor(scheduler, 0, 64, 1, [&](int) { ++visited; });
+    stopTracing();
+    SquareMatrix after = a * a; // not recorded
+
+    std::ostringstream out;
+    writeTrace(out);
+    std::string json = out.str();
+    CHECK(json.rfind("{\"traceEvents\": [", 0) == 0);
+    CHECK(json.find("\"name\": \"matrix_power\", \"cat\": \"operator\", \"ph\": \"X\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"square base\", \"cat\": \"phase\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"multiply rows\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"elimination\"") != std::string::npos);
+    CHECK(json.find("\"cat\": \"task\"") != std::string::npos);
+    CHECK(json.find("\"args\": {\"name\": \"worker 0\"}") != std::string::npos);
+    CHECK(json.find("vector_dot") == std::string::npos); // kernels are off by default
+    CHECK(json.find("\"dropped_events\": 0") != std::string::npos);
+
+    startTracing(true);
+    SquareMatrix withKernels = a * a;
+    stopTracing();
+    std::ostringstream kernels;
+    writeTrace(kernels);
+    CHECK(kernels.str().find("\"name\": \"vector_dot\", \"cat\": \"kernel\"") != std::string::npos);
+    CHECK(kernels.str().find("matrix_power") == std::string::npos); // restarting discards old events
+
+    clearTrace();
+    CHECK_THROWS_AS(writeTrace(std::string("/nonexistent/dir/trace.json")), MyLogicError);
+}
+
+TEST_CASE("Hardware counters") {
+    using namespace ProfilingGM;
+
+    SquareMatrix a(16);
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 16; ++j)
+            a[i][j] = i == j ? 4 : 1;
+
+    CHECK(counterSource() == CounterSource::None);
+    resetHardwareCounters();
+    SquareMatrix untracked = a * a;
+    CHECK(hardwareStats(Operation::MatrixMultiply).calls == 0);
+
+    // The best source available here; hardware events are often missing in containers.
+    CounterSource source = enableHardwareCounters();
+    CHECK(counterSource() == source);
+    if (source != CounterSource::None) {
+        std::vector<std::string> names = counterNames();
+        CHECK_FALSE(names.empty());
+        CHECK(names.size() <= static_cast<size_t>(MAX_HARDWARE_COUNTERS));
+        SquareMatrix product = a * a;
+        HardwareStats multiply = hardwareStats(Operation::MatrixMultiply);
+        CHECK(multiply.calls == 1);
+        CHECK(multiply.values.size() == names.size());
+        CHECK(hardwareStats(Operation::VectorDot).calls == 256);
+        if (source == CounterSource::Hardware && names[0] == "cycles")
+            CHECK(multiply.values[0] > 0);
+    }
+
+    // The rusage fallback works wherever getrusage does.
+    CHECK(enableHardwareCounters(CounterSource::Rusage) == CounterSource::Rusage);
+    CHECK(counterNames() == std::vector<std::string>{"cpu_time_ns", "minor_faults", "major_faults", "context_switches"});
+    CHECK(hardwareStats(Operation::MatrixMultiply).calls == 0); // enabling discards old totals
+    SquareMatrix sum = a + a;
+    CHECK(hardwareStats(Operation::MatrixAdd).calls == 1);
+    CHECK(hardwareStats(Operation::MatrixAdd).values.size() == 4);
+
+    disableHardwareCounters();
+    CHECK(counterSource() == CounterSource::None);
+    SquareMatrix ignored = a + a;
+    CHECK(hardwareStats(Operation::MatrixAdd).calls == 1);
+    resetHardwareCounters();
+    CHECK(hardwareStats(Operation::MatrixAdd).calls == 0);
+}
+
+TEST_CASE("Memory accounting") {
+    using namespace MemoryGM;
+    using Cell = VectorGM::BasicCell<double>;
+
+    MemoryStats before = memoryStats();
+    {
+        VectorGM::Vector v(10);
+        CHECK(memoryStats().liveBytes == before.liveBytes + 10 * sizeof(Cell));
+        CHECK(v.footprint() == sizeof(VectorGM::Vector) + 10 * sizeof(Cell));
+    }
+    CHECK(memoryStats().liveBytes == before.liveBytes);
+    CHECK(memoryStats().allocations > before.allocations);
+
+    SquareMatrix a(8);
+    std::size_t held = a.footprint() - sizeof(SquareMatrix);
+    CHECK(held >= 64 * sizeof(Cell) + 8 * sizeof(VectorGM::Vector));
+    CHECK(memoryStats().liveBytes == before.liveBytes + held);
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j)
+            a[i][j] = i == j ? 2 : 1;
+    SquareMatrix copy = a; // shares the rows
+    CHECK(memoryStats().liveBytes == before.liveBytes + held);
+
+    // The product and the transposed columns are alive at the same time.
+    ProfilingGM::reset();
+    SquareMatrix product = a * copy;
+    CHECK(ProfilingGM::stats(ProfilingGM::Operation::MatrixMultiply).peakTransientBytes >=
+          held + 8 * sizeof(VectorGM::Vector) + 64 * sizeof(Cell));
+    CHECK(ProfilingGM::stats(ProfilingGM::Operation::MatrixDeterminant).peakTransientBytes == 0);
+    double det = !a;
+    CHECK(det == doctest::Approx(9.0)); // det(J + I) = n + 1
+    CHECK(ProfilingGM::stats(ProfilingGM::Operation::MatrixDeterminant).peakTransientBytes == 64 * sizeof(double));
+    CHECK(ProfilingGM::toJson(ProfilingGM::snapshot()).find("\"peak_transient_bytes\": ") != std::string::npos);
+
+    // The factorizations' and view kernels' scratch arrays are recorded too.
+    SquareMatrix l = a.cholesky();
+    CHECK(ProfilingGM::stats(ProfilingGM::Operation::MatrixCholesky).peakTransientBytes >= 64 * sizeof(double));
+    uint64_t allocations = memoryStats().allocations;
+    std::size_t liveBefore = memoryStats().liveBytes;
+    CHECK(SquareMatrix::choleskyDeterminant(l) == doctest::Approx(9.0));
+    const SquareMatrix& readOnly = a;
+    CHECK(!readOnly.block(0, 0, 8) == doctest::Approx(9.0));
+    CHECK(memoryStats().allocations == allocations + 2); // the factor's buffer, the view's gathered copy
+    CHECK(memoryStats().liveBytes == liveBefore);
+
+    resetPeakBytes();
+    std::size_t live = memoryStats().liveBytes;
+    {
+        SquareMatrix temporary(16);
+    }
+    CHECK(memoryStats().liveBytes == live);
+    CHECK(memoryStats().peakBytes >= live + 256 * sizeof(Cell));
+    {
+        SquareMatrixBatch batch(4, 16);
+        ModSquareMatrix<1000000007ULL> modular(8);
+        CHECK(memoryStats().liveBytes == live + 4 * 4 * 16 * sizeof(double) + 8 * 8 * sizeof(uint64_t));
+    }
+    CHECK(memoryStats().liveBytes == live);
+
+    setMemoryBudget(live + 1024);
+    CHECK(memoryBudget() == live + 1024);
+    CHECK_THROWS_AS(SquareMatrix tooBig(32), MemoryBudgetExceeded);
+    CHECK_THROWS_AS(a * a, MemoryBudgetExceeded);
+    CHECK_THROWS_AS(SquareMatrixBatch(32, 64), MemoryBudgetExceeded);
+    CHECK_THROWS_AS(ModSquareMatrix<1000000007ULL>(64), MemoryBudgetExceeded);
+    CHECK(memoryStats().liveBytes == live); // failed allocations are undone
+    setMemoryBudget(0);
+    SquareMatrix fits(32);
+    CHECK(fits.getSize() == 32);
+}
+
+
+
+/**
+ * @brief Shortest of five runs of `func`, in seconds.
+ */
+template <typename Func>
+double fastestRun(Func func) {
+    double best = 0;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (run == 0 || seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+/**
+ * @brief Least-squares slope of log(seconds) over log(size): the k of a running time n^k.
+ */
+double fittedExponent(const std::vector<int>& sizes, const std::vector<double>& seconds) {
+    double meanX = 0, meanY = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        meanX += std::log(static_cast<double>(sizes[i])) / sizes.size();
+        meanY += std::log(seconds[i]) / sizes.size();
+    }
+    double covariance = 0, variance = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        double x = std::log(static_cast<double>(sizes[i])) - meanX;
+        covariance += x * (std::log(seconds[i]) - meanY);
+        variance += x * x;
+    }
+    return covariance / variance;
+}
+
+/**
+ * @brief A well-conditioned n x n matrix: ones on the diagonal, small values elsewhere.
+ */
+SquareMatrix nearIdentity(int n) {
+    SquareMatrix m(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            m[i][j] = i == j ? 1.0 : 1.0 / (n * (1 + (i + 2 * j) % 7));
+    return m;
+}
+
+TEST_CASE("Performance contracts") {
+    // Below the huge-page threshold every row has its own buffer, so a new matrix
+    // costs one row array plus one buffer per row.
+    for (int n : {4, 16, 64}) {
+        CAPTURE(n);
+        uint64_t matrix = static_cast<uint64_t>(n) + 1;
+        SquareMatrix a = nearIdentity(n), b = nearIdentity(n);
+        CHECK(allocationsDuring([&] { SquareMatrix empty(n); }) == matrix);
+        CHECK(allocationsDuring([&] { SquareMatrix sum = a + b; }) == matrix);
+        CHECK(allocationsDuring([&] { SquareMatrix difference = a - b; }) == matrix);
+        CHECK(allocationsDuring([&] { SquareMatrix scaled = a * 2.0; }) == matrix);
+        CHECK(allocationsDuring([&] { SquareMatrix negated = -a; }) == matrix);
+        CHECK(allocationsDuring([&] { a += b; }) == 0);
+        CHECK(allocationsDuring([&] { a *= 0.5; }) == 0);
+        CHECK(allocationsDuring([&] { SquareMatrix product = a * b; }) == 2 * matrix); // plus the transposed columns
+        CHECK(allocationsDuring([&] { (void)!a; }) == 1); // one work array
+        CHECK(allocationsDuring([&] { (void)(a == b); }) == 2); // one row-sum buffer per operand
+        CHECK(allocationsDuring([&] { (void)(a == b); }) == 0); // sums are cached
+        CHECK(allocationsDuring([&] { SquareMatrix copy = a; }) == 0);
+        CHECK(allocationsDuring([&] { SquareMatrix copy = a; copy[0][0] = 1; }) == matrix); // copy on write
+        CHECK(allocationsDuring([&] { SquareMatrix source = a; source[0][0] = 1; SquareMatrix copy = source; })
+              == matrix); // rows written through operator[] are shared again
+
+        // Every heap allocation, accounted or not: a new matrix adds only its shared-row header.
+        SquareMatrix c = nearIdentity(n), d = nearIdentity(n);
+        CHECK(heapAllocationsDuring([&] { SquareMatrix sum = c + d; }) == matrix + 1);
+        CHECK(heapAllocationsDuring([&] { c += d; }) == 0);
+        CHECK(heapAllocationsDuring([&] { c *= 0.5; }) == 0);
+        CHECK(heapAllocationsDuring([&] { SquareMatrix product = c * d; }) == 2 * matrix + 1);
+        CHECK(heapAllocationsDuring([&] { (void)!c; }) == 1);
+        CHECK(heapAllocationsDuring([&] { (void)(c == d); }) == 2);
+        CHECK(heapAllocationsDuring([&] { (void)(c == d); }) == 0);
+        CHECK(heapAllocationsDuring([&] { SquareMatrix copy = c; }) == 0);
+        CHECK(heapAllocationsDuring([&] { SquareMatrix moved = std::move(c); c = std::move(moved); }) == 0);
+        CHECK(c == d);
+    }
+
+    // Elimination is O(n^3); a regression to cofactor expansion would not finish. The
+    // sizes span a factor of 8, so a bound half a power of n above the expected one
+    // still catches an extra factor of n, and the fastest of five runs keeps load spikes
+    // out of the fit. The absolute budget is generous: 200 x 200 takes milliseconds.
+    std::vector<int> sizes = {32, 64, 128, 256};
+    std::vector<double> seconds;
+    for (int n : sizes) {
+        SquareMatrix m = nearIdentity(n);
+        seconds.push_back(fastestRun([&] { (void)!m; }));
+    }
+    CHECK(fittedExponent(sizes, seconds) < 3.5);
+    SquareMatrix m200 = nearIdentity(200);
+    CHECK(fastestRun([&] { (void)!m200; }) < 2.0);
+
+    // Element-wise operators are O(n^2).
+    sizes = {128, 256, 512, 1024};
+    seconds.clear();
+    for (int n : sizes) {
+        SquareMatrix a = nearIdentity(n), b = nearIdentity(n);
+        seconds.push_back(fastestRun([&] { SquareMatrix sum = a + b; }));
+    }
+    CHECK(fittedExponent(sizes, seconds) < 2.5);
+}
+
+TEST_CASE("Fixed-size constexpr matrices") {
+    // Evaluated by the compiler: a failure here is a build error.
+    constexpr FixedSquareMatrix<int64_t, 2> fib{{1, 1}, {1, 0}};
+    constexpr FixedSquareMatrix<int64_t, 2> fib40 = fib ^ 40;
+    static_assert(fib40.get(0, 1) == 102334155, "F(40)");
+    static_assert((!fib) == -1, "determinant");
+    constexpr FixedSquareMatrix<double, 2> quarterTurn{{0, -1}, {1, 0}};
+    static_assert((quarterTurn ^ 4) == FixedSquareMatrix<double, 2>::identity(), "four quarter turns");
+    static_assert((quarterTurn ^ -1) == ~quarterTurn, "a rotation's inverse is its transpose");
+    constexpr FixedSquareMatrix<int, 4> m{{2, 0, 1, 3}, {1, 1, 0, 2}, {0, 3, 1, 1}, {4, 1, 2, 0}};
+    static_assert((!m) == -32, "Bareiss determinant");
+    static_assert((~m).get(0, 3) == 4, "transpose");
+
+    SUBCASE("Matches SquareMatrix at run time") {
+        FixedSquareMatrix<double, 4> d{{2, 0, 1, 3}, {1, 1, 0, 2}, {0, 3, 1, 1}, {4, 1, 2, 0}};
+        SquareMatrix s = d.toSquareMatrix();
+        CHECK(!d == doctest::Approx(!s));
+        SquareMatrix cubed = s ^ 3;
+        SquareMatrix inverse = s ^ -1;
+        FixedSquareMatrix<double, 4> fixedCubed = d ^ 3;
+        FixedSquareMatrix<double, 4> fixedInverse = d ^ -1;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) {
+                CHECK(fixedCubed.get(i, j) == doctest::Approx(cubed[i][j]));
+                CHECK(fixedInverse.get(i, j) == doctest::Approx(inverse[i][j]));
+            }
+        CHECK((d * (d ^ -1)).get(2, 2) == doctest::Approx(1.0));
+    }
+
+    SUBCASE("Errors") {
+        FixedSquareMatrix<double, 2> singular{{1, 2}, {2, 4}};
+        CHECK_THROWS_AS(singular ^ -1, MyLogicError);
+        CHECK_THROWS_AS(fib ^ -1, MyLogicError); // integer elements: no truncated inverse
+        CHECK_THROWS_AS(singular.get(2, 0), MyOutOfRange);
+        CHECK_THROWS_AS((FixedSquareMatrix<int, 2>{{1, 2}}), MyLogicError);
+        std::size_t live = MemoryGM::memoryStats().liveBytes;
+        FixedSquareMatrix<int64_t, 2> f = fib ^ 10;
+        CHECK(f.get(0, 0) == 89);
+        CHECK(MemoryGM::memoryStats().liveBytes == live); // nothing on the heap
+    }
+}
+
+TEST_CASE("Pairwise reductions and Frobenius norm") {
+    SquareMatrix m(2);
+    m[0][0] = 1.0; m[0][1] = -2.0;
+    m[1][0] = 2.0; m[1][1] = 4.0;
+    CHECK(m.frobeniusNorm() == doctest::Approx(5.0));
+    CHECK((~m).frobeniusNorm() == doctest::Approx(5.0));
+
+    BasicSquareMatrix<std::complex<double>> z(1);
+    z[0][0] = std::complex<double>(3.0, 4.0);
+    CHECK(z.frobeniusNorm() == doctest::Approx(5.0));
+
+    SquareMatrix partial(2);
+    partial[0][0] = 1.0;
+    CHECK_THROWS_AS(partial.frobeniusNorm(), MyLogicError);
+
+    // Large enough that the rows are reduced in parallel; the result must not depend on it.
+    const int n = 400;
+    BasicSquareMatrix<float> tenths(n), same(n);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            tenths[i][j] = 0.1f;
+            same[i][j] = 0.1f;
+        }
+    double exact = static_cast<double>(0.1f) * n * n;
+    CHECK(tenths == same);
+    CHECK(std::abs(tenths.frobeniusNorm() - std::sqrt(static_cast<double>(0.1f) * 0.1f * n * n)) < 1e-6);
+    BasicSquareMatrix<float> more = tenths;
+    more[0][0] = 0.1f + static_cast<float>(exact * 1e-4);
+    CHECK(more > tenths); // a 0.01% difference survives the float totals
+}
+
+TEST_CASE("Matrix-vector products") {
+    SquareMatrix a(3);
+    double values[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            a[i][j] = values[i][j];
+    VectorGM::Vector x(3);
+    x[0] = 1.0; x[1] = -1.0; x[2] = 2.0;
+
+    VectorGM::Vector y = a * x;
+    CHECK(y[0] == doctest::Approx(5.0));
+    CHECK(y[1] == doctest::Approx(11.0));
+    CHECK(y[2] == doctest::Approx(19.0));
+    CHECK(y.allInitialized());
+
+    SquareMatrix t = a;
+    ~t; // lazily transposed: t * x is a^T x
+    VectorGM::Vector ty = t * x;
+    CHECK(ty[0] == doctest::Approx(1 - 4 + 14.0));
+    CHECK(ty[2] == doctest::Approx(3 - 6 + 20.0));
+
+    SUBCASE("Several vectors match one at a time") {
+        const int n = 300, k = 11; // two panels, the second partly filled; 10 row tiles by 2 column tiles
+        SquareMatrix m(n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                m[i][j] = std::sin(i * 0.7 + j * 0.3);
+        VectorGM::Vector xs[k];
+        for (int r = 0; r < k; ++r) {
+            xs[r] = VectorGM::Vector(n);
+            for (int j = 0; j < n; ++j)
+                xs[r][j] = std::cos(r + j * 0.1);
+        }
+        SquareMatrix::VectorList ys = m.multiplyVectors(xs, k);
+        CHECK(ys.getSize() == k);
+        for (int r = 0; r < k; ++r) {
+            VectorGM::Vector single = m * xs[r];
+            for (int i = 0; i < n; ++i) {
+                double expected = 0.0;
+                for (int j = 0; j < n; ++j)
+                    expected += m[i][j] * xs[r][j];
+                CHECK(single[i] == doctest::Approx(expected));
+                CHECK(ys[r][i] == doctest::Approx(expected));
+            }
+        }
+        int visited = 0;
+        for (const VectorGM::Vector& product : ys)
+            visited += product.getSize() == n;
+        CHECK(visited == k);
+        CHECK_THROWS_AS(ys[k], MyOutOfRange);
+        SquareMatrix::VectorList moved = std::move(ys);
+        CHECK(moved.getSize() == k);
+        CHECK(ys.getSize() == 0);
+    }
+
+    SUBCASE("Integer elements are exact") {
+        BasicSquareMatrix<int64_t> fib(2);
+        fib[0][0] = 1; fib[0][1] = 1;
+        fib[1][0] = 1; fib[1][1] = 0;
+        VectorGM::BasicVector<int64_t> state(2);
+        state[0] = 1; state[1] = 0;
+        for (int step = 0; step < 90; ++step)
+            state = fib * state;
+        CHECK(state[1] == 2880067194370816120LL); // F(90)
+    }
+
+    SUBCASE("Power iteration") {
+        SquareMatrix s(2);
+        s[0][0] = 2.0; s[0][1] = 1.0;
+        s[1][0] = 1.0; s[1][1] = 2.0;
+        VectorGM::Vector v(2);
+        v[0] = 1.0; v[1] = 0.0;
+        for (int step = 0; step < 60; ++step) {
+            v = s * v;
+            v *= 1.0 / v.norm();
+        }
+        CHECK(v * (s * v) == doctest::Approx(3.0)); // dominant eigenvalue
+    }
+
+    SUBCASE("Errors") {
+        VectorGM::Vector shorter(2), partial(3);
+        shorter[0] = shorter[1] = 1.0;
+        partial[0] = 1.0;
+        CHECK_THROWS_AS(a * shorter, MyLogicError);
+        CHECK_THROWS_AS(a * partial, MyLogicError);
+        SquareMatrix holes(3);
+        CHECK_THROWS_AS(holes * x, MyLogicError);
+        CHECK_THROWS_AS(a.multiplyVectors(&x, 0), MyLogicError);
+        VectorGM::Vector pair[2] = {x, partial};
+        std::size_t live = MemoryGM::memoryStats().liveBytes;
+        CHECK_THROWS_AS(a.multiplyVectors(pair, 2), MyLogicError);
+        CHECK(MemoryGM::memoryStats().liveBytes == live); // nothing leaked
+
+        // A hole in a later tile is caught by that tile's check.
+        const int n = 300;
+        SquareMatrix late(n);
+        VectorGM::Vector ones(n);
+        for (int i = 0; i < n; ++i) {
+            ones[i] = 1.0;
+            for (int j = 0; j < n; ++j)
+                if (i != 250 || j != 280)
+                    late[i][j] = 1.0;
+        }
+        VectorGM::Vector several[2] = {ones, ones};
+        live = MemoryGM::memoryStats().liveBytes;
+        CHECK_THROWS_AS(late * ones, MyLogicError);
+        CHECK_THROWS_AS(late.multiplyVectors(several, 2), MyLogicError);
+        CHECK(MemoryGM::memoryStats().liveBytes == live);
+    }
+}
 
 TEST_CASE("Throw Exception") {
     SquareMatrix m1(2) ,  m2(2) , m5(3) , m6(2);
@@ -291,7 +1911,12 @@ TEST_CASE("Throw Exception") {
     CHECK_THROWS_AS(m1 %= 0, MyLogicError);
     CHECK_THROWS_AS(m1 /= 0, MyLogicError);
     CHECK_THROWS_AS(m1 / 0, MyLogicError);
-    CHECK_THROWS_AS(m1 ^ -3, MyLogicError);
+    SquareMatrix singular(2);
+    singular[0][0] = 1; singular[0][1] = 2;
+    singular[1][0] = 2; singular[1][1] = 4;
+    CHECK_THROWS_AS(singular ^ -3, MyLogicError);
+    CHECK_THROWS_AS(singular.inverse(), MyLogicError);
+    CHECK_THROWS_AS(m6.inverse(), MyLogicError);
     CHECK_THROWS_AS(!m6, MyLogicError);
     CHECK_THROWS_AS(m1<m6, MyLogicError);
 }
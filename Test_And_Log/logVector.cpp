@@ -16,6 +16,7 @@
  * - Pre/Post increment and decrement
  * - Output formatting using operator<<
  * - Transpose functionality with `transposeColumnsToRows`
+ * - Allocation counts of the operators (performance contracts)
  *
  * Exceptions handled:
  * - `MyLogicError` for invalid logic like size mismatch or uninitialized elements
@@ -38,10 +39,15 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <iostream>
 #include "../Vector/Vector.hpp"
+#include "../Memory/MemoryAccounting.hpp"
 #include "Logger.hpp"
 #include "../Exception/MyExceptions.hpp"
 #include "doctest.h" 
 #include <sstream> 
+#include <complex>
+#include <cmath>
+#include <cstdint>
+#include <string>
 
 
 using namespace VectorGM;
@@ -152,8 +158,220 @@ TEST_CASE("Vector core functionality and exceptions") {
 
     Vector colsUninit[2] = {v1, v4};
     CHECK_THROWS_AS(Vector::transposeColumnsToRows(colsUninit, 2), MyLogicError);
-} 
 
+    Vector left(2), right(2);
+    left[0] = 5;
+    right[1] = 6;
+    Vector::swapElements(left, 0, right, 1);
+    CHECK(left[0] == 6);
+    CHECK(right[1] == 5);
+    Vector::swapElements(left, 1, right, 0);
+    CHECK_FALSE(left.isInitialized(1));
+    CHECK_THROWS_AS(Vector::swapElements(left, 2, right, 0), MyOutOfRange);
+}
 
+TEST_CASE("Vector element types") {
+    BasicVector<int64_t> big(2);
+    big[0] = 9007199254740993LL; // 2^53 + 1, not representable as double
+    big[1] = 1;
+    CHECK(big.sum() == 9007199254740994LL);
+    CHECK((big % 10)[0] == 3);
 
+    BasicVector<float> f(3);
+    f[0] = 1.5f; f[1] = 2.5f; f[2] = -1.0f;
+    CHECK(f * f == doctest::Approx(9.5f));
+    CHECK((f / 0.5f)[1] == doctest::Approx(5.0f));
 
+    using Complex = std::complex<double>;
+    BasicVector<Complex> c(2);
+    c[0] = Complex(1, 2);
+    c[1] = Complex(0, 1);
+    CHECK(c * c == Complex(-4, 4));
+    CHECK((++c)[1] == Complex(1, 1));
+    CHECK_THROWS_AS(c % 2, MyLogicError);
+    CHECK_THROWS_AS(c / Complex(0, 0), MyLogicError);
+
+    std::ostringstream oss;
+    BasicVector<int32_t> ints(2);
+    ints[0] = 4;
+    oss << ints;
+    CHECK(oss.str() == "4 [ ] ");
+}
+
+TEST_CASE("Vector allocation contracts") {
+    auto allocations = [] { return MemoryGM::memoryStats().allocations; };
+    Vector v(8), w(8);
+    for (int i = 0; i < 8; ++i) {
+        v[i] = i;
+        w[i] = 2.0;
+    }
+
+    uint64_t before = allocations();
+    Vector sum = v + w; // one buffer, moved into place
+    CHECK(allocations() - before == 1);
+
+    before = allocations();
+    double dot = v * w;
+    v += w;
+    v *= 0.5;
+    Vector moved(std::move(sum));
+    sum = std::move(moved);
+    CHECK(allocations() - before == 0);
+    CHECK(dot == doctest::Approx(56.0));
+    CHECK(sum.getSize() == 8);
+
+    before = allocations();
+    Vector copy = w;
+    copy = v; // same size: buffer reused
+    CHECK(allocations() - before == 1);
+
+    Vector cols[3] = {w, w, w};
+    std::size_t live = MemoryGM::memoryStats().liveBytes;
+    before = allocations();
+    Vector* rows = Vector::transposeColumnsToRows(cols, 3);
+    CHECK(allocations() - before == 9); // the row array and 8 rows
+    Vector::releaseRows(rows, 8);
+    CHECK(MemoryGM::memoryStats().liveBytes == live);
+}
+
+TEST_CASE("Vector status API") {
+    using ErrorGM::Status;
+    Vector a(3), b(3), shorter(2), partial(3);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(a.trySet(i, i + 1.0) == Status::Ok);
+        b[i] = 2.0;
+    }
+    partial[0] = 1.0;
+
+    ErrorGM::Result<Vector> sum = a.tryAdd(b);
+    REQUIRE(sum.ok());
+    CHECK(sum.value()[2] == doctest::Approx(5.0));
+    CHECK(a.tryDot(b).value() == doctest::Approx(12.0));
+    CHECK(a.trySum().value() == doctest::Approx(6.0));
+
+    // Size is checked before initialization, and nothing is thrown.
+    CHECK(partial.tryAdd(shorter).status() == Status::SizeMismatch);
+    CHECK(a.tryHadamard(partial).status() == Status::Uninitialized);
+    CHECK(!a.trySubtract(shorter));
+    CHECK(a.tryDivide(0.0).status() == Status::DivisionByZero);
+    CHECK(partial.tryDivide(0.0).status() == Status::DivisionByZero);
+    CHECK(a.tryModulo(0).status() == Status::DivisionByZero);
+    CHECK(partial.trySum().status() == Status::Uninitialized);
+    CHECK(a.tryGet(3).status() == Status::OutOfRange);
+    CHECK(partial.tryGet(1).status() == Status::Uninitialized);
+    CHECK(a.trySet(-1, 0.0) == Status::OutOfRange);
+    CHECK_THROWS_AS(partial.trySum().value(), MyLogicError);
+
+    // A failed in-place operation leaves the vector untouched.
+    partial[2] = 5.0;
+    CHECK(partial.tryScaleAssign(2.0) == Status::Uninitialized);
+    CHECK(partial.tryIncrement() == Status::Uninitialized);
+    CHECK(partial.tryGet(0).value() == doctest::Approx(1.0));
+    CHECK(partial.tryGet(2).value() == doctest::Approx(5.0));
+    CHECK(a.tryAddAssign(shorter) == Status::SizeMismatch);
+    CHECK(a.tryDivideAssign(2.0) == Status::Ok);
+    CHECK(a.tryGet(1).value() == doctest::Approx(1.0));
+
+    BasicVector<std::complex<double>> z(1);
+    z[0] = std::complex<double>(1.0, 1.0);
+    CHECK(z.tryModulo(2).status() == Status::Unsupported);
+    CHECK_THROWS_AS(z % 2, MyLogicError);
+
+    // The operators keep their exceptions and messages.
+    try {
+        a + shorter;
+        FAIL("expected an exception");
+    } catch (const MyLogicError& e) {
+        CHECK(std::string(e.what()) == "Vector sizes must match for addition");
+    }
+    try {
+        a / 0.0;
+        FAIL("expected an exception");
+    } catch (const MyLogicError& e) {
+        CHECK(std::string(e.what()) == "Division by zero");
+    }
+}
+
+TEST_CASE("Vector reductions") {
+    // Integer sums are exact whatever the order, across leaf and tree sizes.
+    for (int n : {0, 1, 3, 4, 5, 127, 128, 129, 1000}) {
+        BasicVector<int64_t> v(n), w(n);
+        int64_t expectedSum = 0, expectedDot = 0;
+        for (int i = 0; i < n; ++i) {
+            v[i] = i + 1;
+            w[i] = (i % 7) - 3;
+            expectedSum += i + 1;
+            expectedDot += static_cast<int64_t>(i + 1) * ((i % 7) - 3);
+        }
+        CHECK(v.sum() == expectedSum);
+        CHECK(v * w == expectedDot);
+    }
+
+    // A running float total of 2^20 copies of 0.1f drifts by about 1%; pairwise stays near exact.
+    const int n = 1 << 20;
+    BasicVector<float> tenths(n);
+    for (int i = 0; i < n; ++i)
+        tenths[i] = 0.1f;
+    double exact = static_cast<double>(0.1f) * n;
+    CHECK(std::abs(static_cast<double>(tenths.sum()) - exact) / exact < 1e-5);
+
+    Vector v(4);
+    v[0] = 3.0;
+    v[1] = 4.0;
+    v[2] = 0.0;
+    v[3] = 12.0;
+    CHECK(v.norm() == doctest::Approx(13.0));
+    CHECK(v.tryNorm().value() == doctest::Approx(13.0));
+
+    BasicVector<std::complex<double>> z(2);
+    z[0] = std::complex<double>(3.0, 4.0);
+    z[1] = std::complex<double>(0.0, 0.0);
+    CHECK(z.norm() == doctest::Approx(5.0));
+
+    Vector partial(2);
+    partial[0] = 1.0;
+    CHECK_THROWS_AS(partial.norm(), MyLogicError);
+    CHECK(partial.tryNorm().status() == ErrorGM::Status::Uninitialized);
+}
+
+TEST_CASE("Fused axpy kernels") {
+    using ErrorGM::Status;
+    Vector y(3), x(3);
+    for (int i = 0; i < 3; ++i) {
+        y[i] = i + 1.0; // 1 2 3
+        x[i] = 10.0;
+    }
+
+    uint64_t before = MemoryGM::memoryStats().allocations;
+    y.axpy(2.0, x);                  // 21 22 23
+    CHECK(y[0] == doctest::Approx(21.0));
+    y.axpby(0.5, x, -1.0);           // -16 -17 -18
+    CHECK(y[1] == doctest::Approx(-17.0));
+    y.scaleAdd(-1.0, x);             // 26 27 28
+    CHECK(y[2] == doctest::Approx(28.0));
+    y.axpy(1.0, y);                  // aliasing is fine: 52 54 56
+    CHECK(y[0] == doctest::Approx(52.0));
+    CHECK(MemoryGM::memoryStats().allocations == before); // no temporaries
+
+    // b == 0 writes without reading, so the target may start uninitialized.
+    Vector fresh(3);
+    fresh.axpby(3.0, x, 0.0);
+    CHECK(fresh.allInitialized());
+    CHECK(fresh.sum() == doctest::Approx(90.0));
+
+    Vector shorter(2), partial(3);
+    partial[0] = 1.0;
+    CHECK(y.tryAxpy(1.0, shorter) == Status::SizeMismatch);
+    CHECK(y.tryScaleAdd(1.0, partial) == Status::Uninitialized);
+    CHECK(partial.tryAxpby(1.0, x, 2.0) == Status::Uninitialized);
+    CHECK(partial[0] == doctest::Approx(1.0)); // unchanged on failure
+    CHECK_THROWS_AS(y.axpy(1.0, shorter), MyLogicError);
+    CHECK_THROWS_AS(partial.axpy(1.0, x), MyLogicError);
+
+    BasicVector<int64_t> counts(2), step(2);
+    counts[0] = 1; counts[1] = 2;
+    step[0] = 5; step[1] = 7;
+    counts.axpby(2, step, 3);
+    CHECK(counts[0] == 13);
+    CHECK(counts[1] == 20);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ElementTraits.hpp
+ * @brief Per-element-type behavior shared by BasicVector and BasicSquareMatrix.
+ *
+ * Vector and SquareMatrix are templates over their element type. Most operators
+ * only need +, -, * and /, which every supported type provides. The few operations
+ * whose meaning differs between integral, floating-point and complex elements
+ * (scalar modulo, tolerant comparison, ordering, magnitudes for norms, and
+ * conversion to the double buffers used by the factorizations) are routed through ElementTraits.
+ *
+ * Supported element types: float, double, int32_t, int64_t and std::complex<double>.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#ifndef ELEMENT_TRAITS_HPP
+#define ELEMENT_TRAITS_HPP
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include "../Exception/MyExceptions.hpp"
+
+namespace VectorGM {
+
+/**
+ * @brief Traits for real element types (integral and floating point).
+ */
+template <typename T>
+struct ElementTraits {
+    static constexpr bool isFloatingPoint = std::is_floating_point<T>::value; ///< Supports the factorizations
+    static constexpr bool isComplex = false;
+
+    /**
+     * @brief Remainder of `value` divided by `divisor`, truncating floating values first.
+     *
+     * Floating values are truncated and reduced with fmod rather than cast to int, so
+     * magnitudes above 2^31 keep their exact integral part.
+     */
+    static T modulo(T value, int divisor) {
+        if constexpr (std::is_integral<T>::value) {
+            return static_cast<T>(value % divisor);
+        } else {
+            T remainder = std::fmod(std::trunc(value), static_cast<T>(divisor));
+            return remainder == 0 ? T() : remainder;
+        }
+    }
+
+    /**
+     * @brief Equality used by the comparison operators (exact for integers, 1e-9 tolerance otherwise).
+     */
+    static bool nearlyEqual(T a, T b) {
+        if constexpr (std::is_integral<T>::value)
+            return a == b;
+        else
+            return std::abs(a - b) < 1e-9;
+    }
+
+    static bool less(T a, T b) { return a < b; } ///< Ordering used by the comparison operators
+    static double toDouble(T value) { return static_cast<double>(value); }
+    static T fromDouble(double value) { return static_cast<T>(value); }
+    static double magnitudeSquared(T value) { double v = static_cast<double>(value); return v * v; } ///< For norms
+};
+
+/**
+ * @brief Traits for complex element types. Ordering compares magnitudes; modulo is undefined.
+ */
+template <typename T>
+struct ElementTraits<std::complex<T>> {
+    static constexpr bool isFloatingPoint = false;
+    static constexpr bool isComplex = true;
+
+    static std::complex<T> modulo(std::complex<T>, int) {
+        MATRIX_THROW(MyLogicError("Modulo is not defined for complex elements"));
+    }
+
+    static bool nearlyEqual(std::complex<T> a, std::complex<T> b) {
+        return std::abs(a - b) < 1e-9;
+    }
+
+    static bool less(std::complex<T> a, std::complex<T> b) { return std::abs(a) < std::abs(b); }
+    static double toDouble(std::complex<T> value) { return static_cast<double>(value.real()); } ///< Real part only
+    static std::complex<T> fromDouble(double value) { return std::complex<T>(static_cast<T>(value), 0); }
+    static double magnitudeSquared(std::complex<T> value) { return static_cast<double>(std::norm(value)); }
+};
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file Reduction.hpp
+ * @brief Pairwise, multi-accumulator reduction kernels shared by BasicVector and BasicSquareMatrix.
+ *
+ * A single running total makes every add wait for the previous one, and its rounding
+ * error grows with the length of the input. These kernels split the input in halves
+ * down to blocks of REDUCTION_BLOCK elements, reduce each block into REDUCTION_LANES
+ * independent accumulators (so the adds overlap and the compiler can vectorize them),
+ * and add the partial results back up the tree. The error then grows with log n rather
+ * than n, which matters for the 1e-9 tolerance of the comparison operators.
+ *
+ * The kernels read raw cells and do not check initialization; callers validate first.
+ *
+ * Author: Gal Maymon
+ * Email: your.email@example.com
+ */
+
+#ifndef REDUCTION_HPP
+#define REDUCTION_HPP
+
+#include "Vector.hpp"
+
+namespace VectorGM {
+
+constexpr int REDUCTION_BLOCK = 128; ///< Leaf size of the pairwise tree
+constexpr int REDUCTION_LANES = 4;   ///< Independent accumulators per leaf
+
+/**
+ * @brief Sum of term(i) for i in [begin, end), added pairwise.
+ */
+template <typename R, typename Term>
+R pairwiseReduce(int begin, int end, Term term) {
+    int count = end - begin;
+    if (count > REDUCTION_BLOCK) {
+        int middle = begin + (count / 2 + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK * REDUCTION_BLOCK;
+        if (middle >= end)
+            middle = begin + count / 2;
+        return pairwiseReduce<R>(begin, middle, term) + pairwiseReduce<R>(middle, end, term);
+    }
+    R lanes[REDUCTION_LANES] = {};
+    int i = begin;
+    for (; i + REDUCTION_LANES <= end; i += REDUCTION_LANES)
+        for (int lane = 0; lane < REDUCTION_LANES; ++lane)
+            lanes[lane] += term(i + lane);
+    for (; i < end; ++i)
+        lanes[0] += term(i);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+template <typename T>
+T pairwiseSum(const T* values, int count) {
+    return pairwiseReduce<T>(0, count, [values](int i) { return values[i]; });
+}
+
+template <typename T>
+T sumCells(const BasicCell<T>* cells, int count) {
+    return pairwiseReduce<T>(0, count, [cells](int i) { return cells[i].value; });
+}
+
+/**
+ * @brief Dot product without conjugation, like BasicVector::operator*.
+ */
+template <typename T>
+T dotCells(const BasicCell<T>* a, const BasicCell<T>* b, int count) {
+    return pairwiseReduce<T>(0, count, [a, b](int i) { return a[i].value * b[i].value; });
+}
+
+/**
+ * @brief Sum of squared magnitudes, accumulated in double.
+ */
+template <typename T>
+double squaredNormCells(const BasicCell<T>* cells, int count) {
+    return pairwiseReduce<double>(0, count,
+                                  [cells](int i) { return ElementTraits<T>::magnitudeSquared(cells[i].value); });
+}
+
+}
+
+#endif
@@ -1,6 +1,6 @@
 /**
  * @file Vector.cpp
- * @brief Implementation of the Vector class, a 1D array-like structure with support for element-wise operations,
+ * @brief Implementation of the BasicVector class template, a 1D array-like structure with support for element-wise operations,
  *        scalar operations, and initialization tracking.
  *
  * @author Gal
@@ -9,68 +9,232 @@
 
 
 #include "Vector.hpp"
+#include "Reduction.hpp"
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <utility>
 #include "../Exception/MyExceptions.hpp"
+#include "../Memory/HugePages.hpp"
+#include "../Memory/MemoryAccounting.hpp"
+#include "../Profiling/PerfCounters.hpp"
 #include "../Test_And_Log/Logger.hpp"
 
 
 namespace VectorGM {
-Vector::Vector() : data(nullptr), size(0) {
+
+namespace {
+/**
+ * @brief Allocates `size` empty cells; buffers above the huge-page threshold are 2 MiB-aligned.
+ */
+template <typename T>
+BasicCell<T>* allocateCells(int size) {
+    void* memory = MemoryGM::allocate(sizeof(BasicCell<T>) * static_cast<std::size_t>(size));
+    BasicCell<T>* cells = static_cast<BasicCell<T>*>(memory);
+    for (int i = 0; i < size; ++i)
+        new (cells + i) BasicCell<T>();
+    return cells;
+}
+
+/**
+ * @brief Element bytes of `passes` sweeps over `size` cells, for the performance counters.
+ */
+template <typename T>
+uint64_t sweepBytes(int size, int passes) {
+    return static_cast<uint64_t>(passes) * static_cast<uint64_t>(size) * sizeof(BasicCell<T>);
+}
+
+template <typename T>
+void setCell(BasicCell<T>& cell, T value) {
+    cell.value = value;
+    cell.initialized = true;
+}
+
+/**
+ * @brief Preconditions of the element-wise binary operators: equal sizes, then every cell set.
+ */
+template <typename T>
+ErrorGM::Status checkOperands(const BasicVector<T>& a, const BasicVector<T>& b) {
+    if (a.getSize() != b.getSize())
+        return ErrorGM::Status::SizeMismatch;
+    if (!a.allInitialized() || !b.allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    return ErrorGM::Status::Ok;
+}
+
+/**
+ * @brief Preconditions of scalar modulo: a nonzero divisor, every cell set, and a real element type.
+ */
+template <typename T>
+ErrorGM::Status checkModulo(const BasicVector<T>& v, int divisor) {
+    if (divisor == 0)
+        return ErrorGM::Status::DivisionByZero;
+    if (!v.allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    if (ElementTraits<T>::isComplex && v.getSize() > 0)
+        return ErrorGM::Status::Unsupported;
+    return ErrorGM::Status::Ok;
+}
+
+/**
+ * @brief The exception messages an operator has always used, per failed Status (null if it cannot occur).
+ */
+struct Messages {
+    const char* sizeMismatch;
+    const char* uninitialized;
+    const char* divisionByZero;
+};
+
+/**
+ * @brief Throws the exception the throwing operators report for `status`; does nothing for Ok.
+ */
+void raise(ErrorGM::Status status, const Messages& messages) {
+    switch (status) {
+        case ErrorGM::Status::Ok:
+            return;
+        case ErrorGM::Status::SizeMismatch:
+            MATRIX_THROW(MyLogicError(messages.sizeMismatch));
+        case ErrorGM::Status::Uninitialized:
+            MATRIX_THROW(MyLogicError(messages.uninitialized));
+        case ErrorGM::Status::DivisionByZero:
+            MATRIX_THROW(MyLogicError(messages.divisionByZero));
+        case ErrorGM::Status::OutOfRange:
+            MATRIX_THROW(MyOutOfRange());
+        case ErrorGM::Status::Unsupported:
+            MATRIX_THROW(MyLogicError("Modulo is not defined for complex elements"));
+    }
+}
+
+template <typename R>
+R unwrap(ErrorGM::Result<R>&& result, const Messages& messages) {
+    raise(result.status(), messages);
+    return std::move(result.value());
+}
+}
+
+template <typename T>
+BasicVector<T>::BasicVector() : data(nullptr), size(0), ownsData(true), writeCounter(nullptr) {
     LOG(LogLevel::DEBUG, "Default constructor called.");
 }
 
-Vector::Vector(int size) : size(size) {
+template <typename T>
+BasicVector<T>::BasicVector(int size) : size(size), ownsData(true), writeCounter(nullptr) {
     if (size < 0)
-        throw InvalidArgument();
-    data = new Cell[size];
+        MATRIX_THROW(InvalidArgument());
+    data = allocateCells<T>(size);
     LOG(LogLevel::INFO, "Vector of size " << size << " created.");
 }
 
-Vector::Vector(const Vector& other) : size(other.size) {
-    data = new Cell[size];
+template <typename T>
+BasicVector<T>::BasicVector(int size, BasicCell<T>* storage) : data(storage), size(size), ownsData(false), writeCounter(nullptr) {
+    if (size < 0)
+        MATRIX_THROW(InvalidArgument());
+    for (int i = 0; i < size; ++i)
+        new (data + i) BasicCell<T>();
+    LOG(LogLevel::INFO, "Vector of size " << size << " created in external storage.");
+}
+
+template <typename T>
+BasicVector<T>::BasicVector(const BasicVector& other) : size(other.size), ownsData(true), writeCounter(nullptr) {
+    data = allocateCells<T>(size);
     for (int i = 0; i < size; ++i)
         data[i] = other.data[i];
     LOG(LogLevel::DEBUG, "Vector copied (size " << size << ").");
 }
 
-Vector& Vector::operator=(const Vector& other) {
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator=(const BasicVector& other) {
     if (this == &other) return *this;
-    delete[] data;
-    size = other.size;
-    data = new Cell[size];
+    if (size != other.size || !data) {
+        BasicCell<T>* cells = allocateCells<T>(other.size);
+        if (ownsData)
+            MemoryGM::deallocate(data, sizeof(BasicCell<T>) * static_cast<std::size_t>(size));
+        data = cells;
+        size = other.size;
+        ownsData = true;
+    }
     for (int i = 0; i < size; ++i)
         data[i] = other.data[i];
+    noteWrite();
     LOG(LogLevel::DEBUG, "Vector assigned (size " << size << ").");
     return *this;
 }
 
-Vector::~Vector() {
-    delete[] data;
+template <typename T>
+BasicVector<T>::BasicVector(BasicVector&& other)
+    : data(other.data), size(other.size), ownsData(true), writeCounter(nullptr) {
+    if (!other.ownsData) {
+        data = allocateCells<T>(size);
+        for (int i = 0; i < size; ++i)
+            data[i] = other.data[i];
+    } else {
+        other.data = nullptr;
+        other.size = 0;
+    }
+    LOG(LogLevel::DEBUG, "Vector moved (size " << size << ").");
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator=(BasicVector&& other) {
+    if (this == &other) return *this;
+    if (!ownsData || !other.ownsData)
+        return *this = static_cast<const BasicVector&>(other);
+    MemoryGM::deallocate(data, sizeof(BasicCell<T>) * static_cast<std::size_t>(size));
+    data = other.data;
+    size = other.size;
+    other.data = nullptr;
+    other.size = 0;
+    noteWrite();
+    LOG(LogLevel::DEBUG, "Vector move-assigned (size " << size << ").");
+    return *this;
+}
+
+template <typename T>
+BasicVector<T>::~BasicVector() {
+    if (ownsData)
+        MemoryGM::deallocate(data, sizeof(BasicCell<T>) * static_cast<std::size_t>(size)); // cells are trivially destructible
     LOG(LogLevel::DEBUG, "Vector of size " << size << " destroyed.");
 }
 
-double& Vector::operator[](int index) {
+template <typename T>
+T& BasicVector<T>::operator[](int index) {
     if (index < 0 || index >= size)
-        throw MyOutOfRange();
+        MATRIX_THROW(MyOutOfRange());
     data[index].initialized = true;
+    noteWrite();
     LOG(LogLevel::DEBUG, "Element at index " << index << " accessed (write mode).");
     return data[index].value;
 }
 
-const double& Vector::operator[](int index) const {
+template <typename T>
+const T& BasicVector<T>::operator[](int index) const {
     if (index < 0 || index >= size)
-        throw MyOutOfRange();
+        MATRIX_THROW(MyOutOfRange());
     LOG(LogLevel::DEBUG, "Element at index " << index << " accessed (read mode).");
     return data[index].value;
 }
 
-bool Vector::isInitialized(int index) const {
+template <typename T>
+void BasicVector<T>::noteWrite() {
+    if (writeCounter)
+        writeCounter->fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+void BasicVector<T>::observeWrites(std::atomic<uint64_t>* counter) {
+    writeCounter = counter;
+}
+
+template <typename T>
+bool BasicVector<T>::isInitialized(int index) const {
     if (index < 0 || index >= size)
-        throw MyOutOfRange();
+        MATRIX_THROW(MyOutOfRange());
     return data[index].initialized;
 }
 
-bool Vector::allInitialized() const {
+template <typename T>
+bool BasicVector<T>::allInitialized() const {
     for (int i = 0; i < size; ++i) {
         if (!data[i].initialized)
             return false;
@@ -78,89 +242,199 @@ bool Vector::allInitialized() const {
     return true;
 }
 
-int Vector::getSize() const {
+template <typename T>
+int BasicVector<T>::getSize() const {
     return size;
 }
 
+template <typename T>
+std::size_t BasicVector<T>::footprint() const {
+    return sizeof(*this) + (ownsData ? sizeof(BasicCell<T>) * static_cast<std::size_t>(size) : 0);
+}
 
 
-Vector Vector::operator+(const Vector& other) const {
-    LOG(LogLevel::DEBUG, "Performing vector addition.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for addition");
 
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!this->isInitialized(i) || !other.isInitialized(i))
-            throw MyLogicError("Both vectors must be fully initialized for addition");
-        result[i] = data[i].value + other[i];
-    }
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryAdd(const BasicVector& other) const {
+    PROFILE_OPERATION(VectorAdd, sweepBytes<T>(size, 3), size);
+    ErrorGM::Status status = checkOperands(*this, other);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], data[i].value + other.data[i].value);
     return result;
 }
 
-Vector& Vector::operator+=(const Vector& other) {
-    LOG(LogLevel::DEBUG, "Performing vector += operation.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for addition");
+template <typename T>
+BasicVector<T> BasicVector<T>::operator+(const BasicVector& other) const {
+    LOG(LogLevel::DEBUG, "Performing vector addition.");
+    return unwrap(tryAdd(other), Messages{"Vector sizes must match for addition",
+                                          "Both vectors must be fully initialized for addition", nullptr});
+}
 
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryAddAssign(const BasicVector& other) {
+    PROFILE_OPERATION(VectorAddAssign, sweepBytes<T>(size, 3), size);
+    if (size != other.size)
+        return ErrorGM::Status::SizeMismatch;
     for (int i = 0; i < size; ++i)
         data[i].value += other.data[i].value;
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
 
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator+=(const BasicVector& other) {
+    LOG(LogLevel::DEBUG, "Performing vector += operation.");
+    raise(tryAddAssign(other), Messages{"Vector sizes must match for addition", nullptr, nullptr});
     return *this;
 }
 
-Vector Vector::operator-(const Vector& other) const {
-    LOG(LogLevel::DEBUG, "Performing vector subtraction.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for subtraction");
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryAxpy(T a, const BasicVector& x) {
+    PROFILE_OPERATION(VectorAxpy, sweepBytes<T>(size, 3), 2 * static_cast<uint64_t>(size));
+    ErrorGM::Status status = checkOperands(*this, x);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    const BasicCell<T>* source = x.data;
+    for (int i = 0; i < size; ++i)
+        data[i].value += a * source[i].value;
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
 
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!this->isInitialized(i) || !other.isInitialized(i))
-            throw MyLogicError("Both vectors must be fully initialized for subtraction");
-        result[i] = data[i].value - other[i];
+template <typename T>
+BasicVector<T>& BasicVector<T>::axpy(T a, const BasicVector& x) {
+    LOG(LogLevel::DEBUG, "Performing vector axpy.");
+    raise(tryAxpy(a, x), Messages{"Vector sizes must match for axpy",
+                                  "Both vectors must be fully initialized for axpy", nullptr});
+    return *this;
+}
+
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryAxpby(T a, const BasicVector& x, T b) {
+    PROFILE_OPERATION(VectorAxpby, sweepBytes<T>(size, 3), 3 * static_cast<uint64_t>(size));
+    if (size != x.size)
+        return ErrorGM::Status::SizeMismatch;
+    if (!x.allInitialized() || (b != T() && !allInitialized()))
+        return ErrorGM::Status::Uninitialized;
+    const BasicCell<T>* source = x.data;
+    if (b == T()) {
+        // Not read, as in BLAS: old NaNs or uninitialized cells do not leak into the result.
+        for (int i = 0; i < size; ++i)
+            setCell(data[i], a * source[i].value);
+    } else {
+        for (int i = 0; i < size; ++i)
+            data[i].value = a * source[i].value + b * data[i].value;
     }
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::axpby(T a, const BasicVector& x, T b) {
+    LOG(LogLevel::DEBUG, "Performing vector axpby.");
+    raise(tryAxpby(a, x, b), Messages{"Vector sizes must match for axpby",
+                                      "Both vectors must be fully initialized for axpby", nullptr});
+    return *this;
+}
+
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryScaleAdd(T a, const BasicVector& x) {
+    PROFILE_OPERATION(VectorScaleAdd, sweepBytes<T>(size, 3), 2 * static_cast<uint64_t>(size));
+    ErrorGM::Status status = checkOperands(*this, x);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    const BasicCell<T>* source = x.data;
+    for (int i = 0; i < size; ++i)
+        data[i].value = a * data[i].value + source[i].value;
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::scaleAdd(T a, const BasicVector& x) {
+    LOG(LogLevel::DEBUG, "Performing vector scaleAdd.");
+    raise(tryScaleAdd(a, x), Messages{"Vector sizes must match for scaleAdd",
+                                      "Both vectors must be fully initialized for scaleAdd", nullptr});
+    return *this;
+}
+
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::trySubtract(const BasicVector& other) const {
+    PROFILE_OPERATION(VectorSubtract, sweepBytes<T>(size, 3), size);
+    ErrorGM::Status status = checkOperands(*this, other);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], data[i].value - other.data[i].value);
     return result;
 }
 
-Vector& Vector::operator-=(const Vector& other) {
-    LOG(LogLevel::DEBUG, "Performing vector -= operation.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for subtraction");
+template <typename T>
+BasicVector<T> BasicVector<T>::operator-(const BasicVector& other) const {
+    LOG(LogLevel::DEBUG, "Performing vector subtraction.");
+    return unwrap(trySubtract(other), Messages{"Vector sizes must match for subtraction",
+                                               "Both vectors must be fully initialized for subtraction", nullptr});
+}
 
+template <typename T>
+ErrorGM::Status BasicVector<T>::trySubtractAssign(const BasicVector& other) {
+    PROFILE_OPERATION(VectorSubtractAssign, sweepBytes<T>(size, 3), size);
+    if (size != other.size)
+        return ErrorGM::Status::SizeMismatch;
     for (int i = 0; i < size; ++i)
         data[i].value -= other.data[i].value;
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
 
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator-=(const BasicVector& other) {
+    LOG(LogLevel::DEBUG, "Performing vector -= operation.");
+    raise(trySubtractAssign(other), Messages{"Vector sizes must match for subtraction", nullptr, nullptr});
     return *this;
 }
 
-double Vector::operator*(const Vector& other) const {
+template <typename T>
+ErrorGM::Result<T> BasicVector<T>::tryDot(const BasicVector& other) const {
+    PROFILE_OPERATION(VectorDot, sweepBytes<T>(size, 2), 2 * static_cast<uint64_t>(size));
+    ErrorGM::Status status = checkOperands(*this, other);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    return dotCells(data, other.data, size);
+}
+
+template <typename T>
+T BasicVector<T>::operator*(const BasicVector& other) const {
     LOG(LogLevel::DEBUG, "Performing dot product.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for dot product");
+    return unwrap(tryDot(other), Messages{"Vector sizes must match for dot product",
+                                          "Both vectors must be fully initialized for dot product", nullptr});
+}
 
-    double result = 0.0;
-    for (int i = 0; i < size; ++i) {
-        if (!this->isInitialized(i) || !other.isInitialized(i))
-            throw MyLogicError("Both vectors must be fully initialized for dot product");
-        result += data[i].value * other[i];
-    }
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryHadamard(const BasicVector& other) const {
+    PROFILE_OPERATION(VectorHadamard, sweepBytes<T>(size, 3), size);
+    ErrorGM::Status status = checkOperands(*this, other);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], data[i].value * other.data[i].value);
     return result;
 }
 
-Vector Vector::operator%(const Vector& other) const {
+template <typename T>
+BasicVector<T> BasicVector<T>::operator%(const BasicVector& other) const {
     LOG(LogLevel::DEBUG, "Performing element-wise multiplication.");
-    if (size != other.size)
-        throw MyLogicError("Vector sizes must match for element-wise multiplication");
-
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!this->isInitialized(i) || !other.isInitialized(i))
-            throw MyLogicError("Both vectors must be fully initialized for element-wise multiplication");
-        result[i] = data[i].value * other[i];
-    }
-    return result;
+    return unwrap(tryHadamard(other), Messages{"Vector sizes must match for element-wise multiplication",
+                                               "Both vectors must be fully initialized for element-wise multiplication",
+                                               nullptr});
 }
+
+
 /**
  * @brief Converts an array of column vectors into an array of row vectors, for matrix operations.
  * 
@@ -169,169 +443,284 @@ Vector Vector::operator%(const Vector& other) const {
  * @return A new array of Vector objects, transposed into rows.
  * @throws MyLogicError if input is invalid or uninitialized.
  */
-Vector* Vector::transposeColumnsToRows(const Vector* cols, int count) {
+template <typename T>
+BasicVector<T>* BasicVector<T>::transposeColumnsToRows(const BasicVector* cols, int count) {
     LOG(LogLevel::DEBUG, "Transposing columns to rows.");
+    PROFILE_OPERATION(VectorTransposeColumns, 2 * sweepBytes<T>(count, 1) * (count > 0 ? cols[0].getSize() : 0), 0);
     if (count == 0)
-        throw MyLogicError("Empty input");
+        MATRIX_THROW(MyLogicError("Empty input"));
 
     int rowSize = cols[0].getSize();
     for (int i = 1; i < count; ++i) {
         if (cols[i].getSize() != rowSize)
-            throw MyLogicError("All vectors must be the same size");
+            MATRIX_THROW(MyLogicError("All vectors must be the same size"));
     }
 
-    Vector* result = new Vector[rowSize];
-    try {
+    BasicVector* result = MemoryGM::allocateArray<BasicVector>(static_cast<std::size_t>(rowSize));
+    MATRIX_TRY {
         for (int i = 0; i < rowSize; ++i)
-            result[i] = Vector(count);
+            result[i] = BasicVector(count); // moved in: one buffer per row
 
         for (int i = 0; i < rowSize; ++i) {
             for (int j = 0; j < count; ++j) {
                 if (!cols[j].isInitialized(i))
-                    throw MyLogicError("Column vector is not fully initialized");
+                    MATRIX_THROW(MyLogicError("Column vector is not fully initialized"));
                 result[i][j] = cols[j][i];
             }
         }
-    } catch (...) {
-        delete[] result;
-        throw;
+    } MATRIX_CATCH_ALL {
+        MemoryGM::releaseArray(result, static_cast<std::size_t>(rowSize));
+        MATRIX_RETHROW;
     }
 
     return result;
 }
 
-Vector Vector::operator-() const {
+template <typename T>
+void BasicVector<T>::releaseRows(BasicVector* rows, int count) {
+    MemoryGM::releaseArray(rows, static_cast<std::size_t>(count));
+}
+
+template <typename T>
+void BasicVector<T>::swapElements(BasicVector& a, int i, BasicVector& b, int j) {
+    if (i < 0 || i >= a.size || j < 0 || j >= b.size)
+        MATRIX_THROW(MyOutOfRange());
+    BasicCell<T> tmp = a.data[i];
+    a.data[i] = b.data[j];
+    b.data[j] = tmp;
+    a.noteWrite();
+    if (&b != &a)
+        b.noteWrite();
+}
+
+template <typename T>
+ErrorGM::Result<T> BasicVector<T>::tryGet(int index) const {
+    if (index < 0 || index >= size)
+        return ErrorGM::Status::OutOfRange;
+    if (!data[index].initialized)
+        return ErrorGM::Status::Uninitialized;
+    return data[index].value;
+}
+
+template <typename T>
+ErrorGM::Status BasicVector<T>::trySet(int index, T value) {
+    if (index < 0 || index >= size)
+        return ErrorGM::Status::OutOfRange;
+    setCell(data[index], value);
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicCell<T>* BasicVector<T>::cells() {
+    return data;
+}
+
+template <typename T>
+const BasicCell<T>* BasicVector<T>::cells() const {
+    return data;
+}
+
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryNegate() const {
+    PROFILE_OPERATION(VectorNegate, sweepBytes<T>(size, 2), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], -data[i].value);
+    return result;
+}
+
+template <typename T>
+BasicVector<T> BasicVector<T>::operator-() const {
     LOG(LogLevel::DEBUG, "Negating vector.");
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!this->isInitialized(i))
-            throw MyLogicError("Cannot negate uninitialized cell in vector");
-        result[i] = -data[i].value;
-    }
+    return unwrap(tryNegate(), Messages{nullptr, "Cannot negate uninitialized cell in vector", nullptr});
+}
+
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryScale(T scalar) const {
+    PROFILE_OPERATION(VectorScale, sweepBytes<T>(size, 2), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], data[i].value * scalar);
     return result;
 }
 
-Vector Vector::operator*(double scalar) const {
+template <typename T>
+BasicVector<T> BasicVector<T>::operator*(T scalar) const {
     LOG(LogLevel::DEBUG, "Multiplying vector by scalar.");
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot multiply uninitialized cell");
-        result[i] = data[i].value * scalar;
-    }
-    return result;
+    return unwrap(tryScale(scalar), Messages{nullptr, "Cannot multiply uninitialized cell", nullptr});
 }
 
-Vector& Vector::operator*=(double scalar) {
-    LOG(LogLevel::DEBUG, "Performing vector *= scalar operation.");
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot multiply uninitialized cell");
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryScaleAssign(T scalar) {
+    PROFILE_OPERATION(VectorScaleAssign, sweepBytes<T>(size, 2), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    for (int i = 0; i < size; ++i)
         data[i].value *= scalar;
-    }
-    return *this;
+    noteWrite();
+    return ErrorGM::Status::Ok;
 }
 
-Vector Vector::operator%(int scalar) const {
-    LOG(LogLevel::DEBUG, "Performing vector % scalar operation.");
-    if (scalar == 0)
-        throw MyLogicError("Modulo by zero");
-
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot modulo uninitialized cell");
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator*=(T scalar) {
+    LOG(LogLevel::DEBUG, "Performing vector *= scalar operation.");
+    raise(tryScaleAssign(scalar), Messages{nullptr, "Cannot multiply uninitialized cell", nullptr});
+    return *this;
+}
 
-        int valAsInt = static_cast<int>(data[i].value);
-        result[i] = valAsInt % scalar;
-    }
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryModulo(int scalar) const {
+    PROFILE_OPERATION(VectorModulo, sweepBytes<T>(size, 2), size);
+    ErrorGM::Status status = checkModulo(*this, scalar);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], ElementTraits<T>::modulo(data[i].value, scalar));
     return result;
 }
 
-Vector& Vector::operator%=(int scalar) {
-    LOG(LogLevel::DEBUG, "Performing vector %= scalar operation.");
-    if (scalar == 0)
-        throw MyLogicError("Modulo by zero");
+template <typename T>
+BasicVector<T> BasicVector<T>::operator%(int scalar) const {
+    LOG(LogLevel::DEBUG, "Performing vector % scalar operation.");
+    return unwrap(tryModulo(scalar), Messages{nullptr, "Cannot modulo uninitialized cell", "Modulo by zero"});
+}
 
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot modulo uninitialized cell");
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryModuloAssign(int scalar) {
+    PROFILE_OPERATION(VectorModuloAssign, sweepBytes<T>(size, 2), size);
+    ErrorGM::Status status = checkModulo(*this, scalar);
+    if (status != ErrorGM::Status::Ok)
+        return status;
+    for (int i = 0; i < size; ++i)
+        data[i].value = ElementTraits<T>::modulo(data[i].value, scalar);
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
 
-        int valAsInt = static_cast<int>(data[i].value);
-        data[i].value = valAsInt % scalar;
-    }
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator%=(int scalar) {
+    LOG(LogLevel::DEBUG, "Performing vector %= scalar operation.");
+    raise(tryModuloAssign(scalar), Messages{nullptr, "Cannot modulo uninitialized cell", "Modulo by zero"});
     return *this;
 }
 
-Vector Vector::operator/(double scalar) const {
-    LOG(LogLevel::DEBUG, "Performing vector / scalar operation.");
-    if (scalar == 0)
-        throw MyLogicError("Division by zero");
-
-    Vector result(size);
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot divide uninitialized cell");
-        result[i] = data[i].value / scalar;
-    }
+template <typename T>
+ErrorGM::Result<BasicVector<T>> BasicVector<T>::tryDivide(T scalar) const {
+    PROFILE_OPERATION(VectorDivide, sweepBytes<T>(size, 2), size);
+    if (scalar == T())
+        return ErrorGM::Status::DivisionByZero;
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    BasicVector result(size);
+    for (int i = 0; i < size; ++i)
+        setCell(result.data[i], data[i].value / scalar);
     return result;
 }
 
-Vector& Vector::operator/=(double scalar) {
-    LOG(LogLevel::DEBUG, "Performing vector /= scalar operation.");
-    if (scalar == 0)
-        throw MyLogicError("Division by zero");
+template <typename T>
+BasicVector<T> BasicVector<T>::operator/(T scalar) const {
+    LOG(LogLevel::DEBUG, "Performing vector / scalar operation.");
+    return unwrap(tryDivide(scalar), Messages{nullptr, "Cannot divide uninitialized cell", "Division by zero"});
+}
 
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Cannot divide uninitialized cell");
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryDivideAssign(T scalar) {
+    PROFILE_OPERATION(VectorDivideAssign, sweepBytes<T>(size, 2), size);
+    if (scalar == T())
+        return ErrorGM::Status::DivisionByZero;
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    for (int i = 0; i < size; ++i)
         data[i].value /= scalar;
-    }
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator/=(T scalar) {
+    LOG(LogLevel::DEBUG, "Performing vector /= scalar operation.");
+    raise(tryDivideAssign(scalar), Messages{nullptr, "Cannot divide uninitialized cell", "Division by zero"});
     return *this;
 }
 
-Vector& Vector::operator++() {
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryIncrement() {
+    PROFILE_OPERATION(VectorIncrement, sweepBytes<T>(size, 2), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    for (int i = 0; i < size; ++i)
+        data[i].value += T(1);
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator++() {
     LOG(LogLevel::DEBUG, "Pre-incrementing vector.");
-    for (int i = 0; i < size; ++i) {
-        if (!data[i].initialized)
-            throw MyLogicError("Cannot increment uninitialized cell");
-        data[i].value += 1;
-    }
+    raise(tryIncrement(), Messages{nullptr, "Cannot increment uninitialized cell", nullptr});
     return *this;
 }
 
-Vector Vector::operator++(int) {
+template <typename T>
+BasicVector<T> BasicVector<T>::operator++(int) {
     LOG(LogLevel::DEBUG, "Post-incrementing vector.");
-    Vector temp = *this;
+    BasicVector temp = *this;
     ++(*this);
     return temp;
 }
 
-Vector& Vector::operator--() {
+template <typename T>
+ErrorGM::Status BasicVector<T>::tryDecrement() {
+    PROFILE_OPERATION(VectorDecrement, sweepBytes<T>(size, 2), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    for (int i = 0; i < size; ++i)
+        data[i].value -= T(1);
+    noteWrite();
+    return ErrorGM::Status::Ok;
+}
+
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator--() {
     LOG(LogLevel::DEBUG, "Pre-decrementing vector.");
-    for (int i = 0; i < size; ++i) {
-        if (!data[i].initialized)
-            throw MyLogicError("Cannot decrement uninitialized cell");
-        data[i].value -= 1;
-    }
+    raise(tryDecrement(), Messages{nullptr, "Cannot decrement uninitialized cell", nullptr});
     return *this;
 }
 
-Vector Vector::operator--(int) {
+template <typename T>
+BasicVector<T> BasicVector<T>::operator--(int) {
     LOG(LogLevel::DEBUG, "Post-decrementing vector.");
-    Vector temp = *this;
+    BasicVector temp = *this;
     --(*this);
     return temp;
 }
 
-std::ostream& operator<<(std::ostream& os, const Vector& vec) {
-    for (int i = 0; i < vec.size; ++i) {
-        if (vec.data[i].initialized)
-            os << vec.data[i].value << " ";
-        else
-            os << "[ ] ";
-    }
-    return os;
+template <typename T>
+ErrorGM::Result<T> BasicVector<T>::trySum() const {
+    PROFILE_OPERATION(VectorSum, sweepBytes<T>(size, 1), size);
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    return sumCells(data, size);
+}
+
+template <typename T>
+ErrorGM::Result<double> BasicVector<T>::tryNorm() const {
+    PROFILE_OPERATION(VectorNorm, sweepBytes<T>(size, 1), 2 * static_cast<uint64_t>(size));
+    if (!allInitialized())
+        return ErrorGM::Status::Uninitialized;
+    return std::sqrt(squaredNormCells(data, size));
+}
+
+template <typename T>
+double BasicVector<T>::norm() const {
+    LOG(LogLevel::DEBUG, "Computing vector norm.");
+    return unwrap(tryNorm(), Messages{nullptr, "Uninitialized cell in vector during norm()", nullptr});
 }
 
 /**
@@ -342,18 +731,20 @@ std::ostream& operator<<(std::ostream& os, const Vector& vec) {
  * @throws MyLogicError if any element in the vector is not initialized.
  * 
  * @note This method assumes that all elements must be initialized before summation.
+ *       Elements are added pairwise with several accumulators (Reduction.hpp).
  *       It is useful when evaluating the total magnitude or comparing vectors/matrices.
  */
+template <typename T>
+T BasicVector<T>::sum() const {
+    return unwrap(trySum(), Messages{nullptr, "Uninitialized cell in vector during sum()", nullptr});
+}
 
 
-double Vector::sum() const {
-    double total = 0.0;
-    for (int i = 0; i < size; ++i) {
-        if (!isInitialized(i))
-            throw MyLogicError("Uninitialized cell in vector during sum()");
-        total += data[i].value;
-    }
-    return total;
-}
+// Explicit instantiations: every supported element type gets its own compiled kernels.
+template class BasicVector<float>;
+template class BasicVector<double>;
+template class BasicVector<int32_t>;
+template class BasicVector<int64_t>;
+template class BasicVector<std::complex<double>>;
 
-}
\ No newline at end of file
+}
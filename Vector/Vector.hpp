@@ -1,7 +1,12 @@
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
+#include "ElementTraits.hpp"
+#include "../Exception/Status.hpp"
 
 namespace VectorGM {
 
@@ -10,55 +15,89 @@ namespace VectorGM {
  * Author: Gal Maymon
  * Email: your.email@example.com
  * 
- * Each cell holds a `value` (double) and a flag `initialized` to track whether the value has been explicitly set.
+ * Each cell holds a `value` of the element type and a flag `initialized` to track whether the value has been explicitly set.
  */
-struct Cell {
-    double value;
+template <typename T>
+struct BasicCell {
+    T value;
     bool initialized;
 
-    Cell() : value(0.0), initialized(false) {}
+    BasicCell() : value(), initialized(false) {}
 };
 
+using Cell = BasicCell<double>;
+
 /**
  * @brief A custom one-dimensional vector class with support for initialization tracking and arithmetic operations.
  * 
  * The Vector class supports element access, initialization checks, arithmetic operations (element-wise and scalar),
  * and advanced features like transpose, increment/decrement operators, and summation.
+ *
+ * It is a template over the element type T; `Vector` is the original double-precision vector.
+ * The implementation is explicitly instantiated in Vector.cpp for float, double, int32_t,
+ * int64_t and std::complex<double>.
  */
-class Vector {
+template <typename T>
+class BasicVector {
 
 private:
-    Cell* data;   ///< Pointer to an array of Cell elements
-    int size;     ///< Length of the vector
+    BasicCell<T>* data; ///< Pointer to an array of Cell elements
+    int size;           ///< Length of the vector
+    bool ownsData;      ///< False when the cells live in a caller's buffer (a matrix slab)
+    std::atomic<uint64_t>* writeCounter; ///< Bumped by every write, or nullptr (see observeWrites)
+
+    void noteWrite(); ///< Bumps writeCounter, if any
 
 public:
+    using value_type = T; ///< Element type
+
     // === Constructors and Destructor ===
 
     /**
      * @brief Default constructor. Creates an empty vector.
      */
-    Vector();
+    BasicVector();
 
     /**
      * @brief Constructs a vector with a given size.
      * @param size The number of elements in the vector.
      */
-    Vector(int size);
+    BasicVector(int size);
+
+    /**
+     * @brief Constructs a vector of `size` empty cells inside `storage`, which the caller owns.
+     *
+     * Used by matrices that keep all rows in one huge-page slab. The storage must hold
+     * `size` cells and outlive the vector; assigning a vector of another size moves the
+     * cells to a buffer of the vector's own.
+     */
+    BasicVector(int size, BasicCell<T>* storage);
 
     /**
      * @brief Copy constructor.
      */
-    Vector(const Vector& other);
+    BasicVector(const BasicVector& other);
+
+    /**
+     * @brief Copy assignment operator. Reuses the current buffer when the sizes match.
+     */
+    BasicVector& operator=(const BasicVector& other);
+
+    /**
+     * @brief Move constructor. Takes over the cells of `other`, unless they are borrowed, which are copied.
+     */
+    BasicVector(BasicVector&& other);
 
     /**
-     * @brief Copy assignment operator.
+     * @brief Move assignment. Takes over the cells of `other`; copies instead when either
+     * vector's cells are borrowed, so a slab row keeps its place in the slab.
      */
-    Vector& operator=(const Vector& other);
+    BasicVector& operator=(BasicVector&& other);
 
     /**
      * @brief Destructor. Releases dynamically allocated memory.
      */
-    ~Vector();
+    ~BasicVector();
 
     // === Element Access ===
 
@@ -66,12 +105,12 @@ public:
      * @brief Accesses the element at a given index (modifiable).
      * Marks the element as initialized.
      */
-    double& operator[](int index);
+    T& operator[](int index);
 
     /**
      * @brief Accesses the element at a given index (read-only).
      */
-    const double& operator[](int index) const;
+    const T& operator[](int index) const;
 
     /**
      * @brief Checks if a specific index has been initialized.
@@ -88,49 +127,156 @@ public:
      */
     int getSize() const;
 
+    /**
+     * @brief Bytes this vector holds: the object and, unless borrowed from a matrix slab, its cells.
+     */
+    std::size_t footprint() const;
+
     /**
      * @brief Calculates and returns the sum of all initialized values in the vector.
      */
-    double sum() const;
+    T sum() const;
+
+    /**
+     * @brief Euclidean norm, sqrt of the sum of squared magnitudes (accumulated in double).
+     * @throws MyLogicError if any element is not initialized.
+     */
+    double norm() const;
 
     // === Arithmetic Operations ===
 
-    Vector operator+(const Vector& other) const;
-    Vector& operator+=(const Vector& other);
-    Vector operator-(const Vector& other) const;
-    Vector& operator-=(const Vector& other);
-    Vector operator%(const Vector& other) const;
+    BasicVector operator+(const BasicVector& other) const;
+    BasicVector& operator+=(const BasicVector& other);
+    BasicVector operator-(const BasicVector& other) const;
+    BasicVector& operator-=(const BasicVector& other);
+    BasicVector operator%(const BasicVector& other) const;
+
+    /**
+     * @brief Computes the dot product between two vectors (no conjugation for complex elements).
+     */
+    T operator*(const BasicVector& other) const;
+
+    // === Fused BLAS-1 updates ===
+    // One pass over both vectors with no temporary, unlike `v += x * a`.
+
+    /**
+     * @brief this = this + a * x.
+     * @throws MyLogicError if the sizes differ or either vector is not fully initialized.
+     */
+    BasicVector& axpy(T a, const BasicVector& x);
+
+    /**
+     * @brief this = a * x + b * this. With b == 0 this is only written, so it may be uninitialized.
+     * @throws MyLogicError if the sizes differ or an operand that is read is not fully initialized.
+     */
+    BasicVector& axpby(T a, const BasicVector& x, T b);
 
     /**
-     * @brief Computes the dot product between two vectors.
+     * @brief this = a * this + x.
+     * @throws MyLogicError if the sizes differ or either vector is not fully initialized.
      */
-    double operator*(const Vector& other) const;
+    BasicVector& scaleAdd(T a, const BasicVector& x);
 
     /**
      * @brief Converts a list of column vectors into a list of row vectors (used for matrix multiplication).
+     * Free the result with releaseRows().
+     */
+    static BasicVector* transposeColumnsToRows(const BasicVector* cols, int count);
+
+    /**
+     * @brief Frees the `count` rows returned by transposeColumnsToRows().
+     */
+    static void releaseRows(BasicVector* rows, int count);
+
+    /**
+     * @brief Swaps cell `i` of `a` with cell `j` of `b`, including their initialization state.
+     * @throws MyOutOfRange if either index is out of range.
+     */
+    static void swapElements(BasicVector& a, int i, BasicVector& b, int j);
+
+    /**
+     * @brief Makes every later write through this vector bump `counter` (nullptr stops it).
+     *
+     * A matrix sets it on its rows, so a result it caches (the sum) is invalidated even by
+     * writes through a row reference held by the caller. The mutable operator[], trySet,
+     * the assignments and all in-place operations count as writes; cells() does not.
+     * Copies and moved-to vectors start without a counter.
+     */
+    void observeWrites(std::atomic<uint64_t>* counter);
+
+    /**
+     * @brief Raw cell storage, for kernels (such as matrix views) that check bounds themselves.
+     * Unlike operator[], it neither checks the index nor logs, and writes do not mark cells
+     * initialized or bump the observeWrites() counter; callers that write report it themselves.
+     */
+    BasicCell<T>* cells();
+
+    /**
+     * @brief Raw cell storage (read-only).
      */
-    static Vector* transposeColumnsToRows(const Vector* cols, int count);
+    const BasicCell<T>* cells() const;
 
-    Vector operator-() const;
-    Vector operator*(double scalar) const;
-    Vector& operator*=(double scalar);
-    Vector operator%(int scalar) const;
-    Vector& operator%=(int scalar);
-    Vector operator/(double scalar) const;
-    Vector& operator/=(double scalar);
+    BasicVector operator-() const;
+    BasicVector operator*(T scalar) const;
+    BasicVector& operator*=(T scalar);
+    BasicVector operator%(int scalar) const;
+    BasicVector& operator%=(int scalar);
+    BasicVector operator/(T scalar) const;
+    BasicVector& operator/=(T scalar);
 
     // === Increment / Decrement ===
-    Vector& operator++();      ///< Prefix increment (adds 1 to each initialized element)
-    Vector operator++(int);    ///< Postfix increment
-    Vector& operator--();      ///< Prefix decrement (subtracts 1 from each initialized element)
-    Vector operator--(int);    ///< Postfix decrement
+    BasicVector& operator++();      ///< Prefix increment (adds 1 to each initialized element)
+    BasicVector operator++(int);    ///< Postfix increment
+    BasicVector& operator--();      ///< Prefix decrement (subtracts 1 from each initialized element)
+    BasicVector operator--(int);    ///< Postfix decrement
+
+    // === Non-throwing API ===
+    // Each try... member checks all of its preconditions once, before touching any cell,
+    // and reports the first that fails (sizes, then initialization, then the scalar)
+    // instead of throwing; a failed assignment leaves the vector unchanged. The operators
+    // above are wrappers that throw the corresponding exception. See Status.hpp.
+
+    ErrorGM::Result<T> tryGet(int index) const;        ///< Value of an initialized cell
+    ErrorGM::Status trySet(int index, T value);         ///< Sets and initializes a cell
+
+    ErrorGM::Result<BasicVector> tryAdd(const BasicVector& other) const;
+    ErrorGM::Result<BasicVector> trySubtract(const BasicVector& other) const;
+    ErrorGM::Result<BasicVector> tryHadamard(const BasicVector& other) const; ///< Element-wise product
+    ErrorGM::Result<T> tryDot(const BasicVector& other) const;
+    ErrorGM::Status tryAddAssign(const BasicVector& other);      ///< Checks the sizes only, like +=
+    ErrorGM::Status tryAxpy(T a, const BasicVector& x);
+    ErrorGM::Status tryAxpby(T a, const BasicVector& x, T b);
+    ErrorGM::Status tryScaleAdd(T a, const BasicVector& x);
+    ErrorGM::Status trySubtractAssign(const BasicVector& other); ///< Checks the sizes only, like -=
+
+    ErrorGM::Result<BasicVector> tryNegate() const;
+    ErrorGM::Result<BasicVector> tryScale(T scalar) const;
+    ErrorGM::Result<BasicVector> tryModulo(int scalar) const; ///< Unsupported for complex elements
+    ErrorGM::Result<BasicVector> tryDivide(T scalar) const;
+    ErrorGM::Status tryScaleAssign(T scalar);
+    ErrorGM::Status tryModuloAssign(int scalar);
+    ErrorGM::Status tryDivideAssign(T scalar);
+    ErrorGM::Status tryIncrement();
+    ErrorGM::Status tryDecrement();
+    ErrorGM::Result<T> trySum() const;
+    ErrorGM::Result<double> tryNorm() const;
 
     /**
      * @brief Prints the vector in human-readable format (e.g., [1.0, 2.0, ...]).
      */
-    friend std::ostream& operator<<(std::ostream& os, const Vector& vec);
+    friend std::ostream& operator<<(std::ostream& os, const BasicVector& vec) {
+        for (int i = 0; i < vec.size; ++i) {
+            if (vec.data[i].initialized)
+                os << vec.data[i].value << " ";
+            else
+                os << "[ ] ";
+        }
+        return os;
+    }
 };
 
+using Vector = BasicVector<double>;
+
 }
 
 #endif